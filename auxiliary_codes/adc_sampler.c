@@ -0,0 +1,332 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "adc_sampler.h"                    // Declarações da aquisição por DMA
+#include "pico/stdlib.h"                    // Temporização (time_us_64)
+#include "hardware/adc.h"                   // ADC em modo free-running
+#include "hardware/dma.h"                   // Canais DMA em ping-pong
+#include "hardware/irq.h"                   // IRQ compartilhado do DMA
+#include "hardware/gpio.h"                  // Seleção do multiplexador externo
+#include "prof.h"                           // Tempo do IRQ
+
+// ===== ESTADO DA AQUISIÇÃO =====
+// Dois blocos: enquanto o DMA preenche um, o IRQ decima o outro. Cada
+// canal escreve num anel do tamanho do seu bloco, alinhado: se o IRQ não
+// rebobinar o endereço a tempo, o DMA sobrescreve o próprio bloco em vez
+// de sair dele.
+#define ADC_BLOCK_RING_BITS 9               // log2 dos bytes de um bloco
+static uint16_t adc_blocks[2][ADC_SAMPLER_BLOCK_SAMPLES]
+    __attribute__((aligned(1u << ADC_BLOCK_RING_BITS)));
+_Static_assert(sizeof(adc_blocks[0]) == (1u << ADC_BLOCK_RING_BITS), "anel do DMA = um bloco");
+static int dma_chan[2] = {-1, -1};
+static bool paused;                         // Parado por adc_sampler_pause, canais ainda nossos
+
+// Round-robin: o ADC percorre as entradas habilitadas em ordem crescente,
+// então a entrada de cada amostra segue da posição no fluxo
+static uint8_t rr_inputs[ADC_SAMPLER_MAX_INPUTS];
+static uint32_t rr_count;
+static uint32_t rr_pos;                    // Entrada da próxima amostra (atravessa blocos)
+
+// Acumuladores da decimação por entrada (podem atravessar vários blocos)
+static uint32_t oversample_log2;
+static uint32_t acc_sum[ADC_SAMPLER_MAX_INPUTS];
+static uint32_t acc_count[ADC_SAMPLER_MAX_INPUTS];
+
+// Multiplexador externo numa das entradas
+static adc_sampler_config_t config;
+static uint8_t mux_channel;                // Canal selecionado agora
+static volatile uint32_t mux_scan;         // Canais percorridos (0 = todos)
+static uint32_t blocks_done;
+static uint32_t mux_valid_from;            // Primeiro bloco com o canal novo estável
+
+// Fila SPSC de leituras: o IRQ produz, o laço principal consome
+static adc_sampler_reading_t queue[ADC_SAMPLER_QUEUE_LEN];
+static volatile uint32_t queue_head;       // Escrito somente pelo IRQ
+static volatile uint32_t queue_tail;       // Escrito somente pelo consumidor
+
+static volatile adc_sampler_stats_t stats;
+
+// Publica uma leitura decimada na fila (contexto de IRQ)
+static void __not_in_flash_func(publish_reading)(uint32_t input, uint64_t now_us) {
+    uint32_t head = queue_head;
+    stats.readings++;
+    if (head - queue_tail >= ADC_SAMPLER_QUEUE_LEN) {
+        stats.dropped_readings++;           // Consumidor atrasado: descarta a nova leitura
+        return;
+    }
+
+    adc_sampler_reading_t *r = &queue[head % ADC_SAMPLER_QUEUE_LEN];
+    r->value = acc_sum[input] >> (oversample_log2 / 2);
+    r->mean = (uint16_t)(acc_sum[input] >> oversample_log2);
+    r->bits = 12 + oversample_log2 / 2;
+    r->input = (uint8_t)input;
+    r->mux = input == config.mux_input ? mux_channel : ADC_SAMPLER_NO_MUX;
+    r->timestamp_us = now_us;
+
+    __compiler_memory_barrier();
+    queue_head = head + 1;
+}
+
+static void __not_in_flash_func(mux_select)(uint32_t channel) {
+    uint32_t mask = ((1u << ADC_SAMPLER_MUX_SELECT_BITS) - 1) << config.mux_select_gpio;
+    gpio_put_masked(mask, channel << config.mux_select_gpio);
+    mux_channel = (uint8_t)channel;
+}
+
+// Próximo canal da varredura. O bloco atual e o seguinte podem ter amostras
+// de antes da troca: essa entrada só volta a contar dois blocos depois.
+static void __not_in_flash_func(mux_advance)(void) {
+    uint32_t scan = mux_scan;
+    uint32_t next = mux_channel;
+    for (uint32_t i = 0; i < config.mux_channels; i++) {
+        next = (next + 1) % config.mux_channels;
+        if (scan == 0 || (scan & (1u << next))) break;
+    }
+    if (next != mux_channel) {
+        mux_select(next);
+        mux_valid_from = blocks_done + 2;
+    }
+}
+
+// Decima um bloco completo de amostras
+static void __not_in_flash_func(process_block)(const uint16_t *block) {
+    const uint32_t target = 1u << oversample_log2;
+    uint64_t now_us = time_us_64();
+
+    for (int i = 0; i < ADC_SAMPLER_BLOCK_SAMPLES; i++) {
+        uint32_t input = rr_inputs[rr_pos];
+        if (++rr_pos == rr_count) rr_pos = 0;
+        uint16_t s = block[i];
+        if (s & 0x8000) {                   // Bit 15 = erro de conversão (err_in_fifo)
+            stats.conversion_errors++;
+            continue;
+        }
+        if (input == config.mux_input && blocks_done < mux_valid_from) {
+            continue;                       // Multiplexador estabilizando
+        }
+        acc_sum[input] += s & 0x0FFF;
+        if (++acc_count[input] == target) {
+            publish_reading(input, now_us);
+            acc_sum[input] = 0;
+            acc_count[input] = 0;
+            if (input == config.mux_input) {
+                mux_advance();
+            }
+        }
+    }
+    blocks_done++;
+}
+
+// Para o ADC e os dois canais (sem soltá-los), com o FIFO vazio
+static void __not_in_flash_func(acquisition_halt)(void) {
+    adc_run(false);
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) {
+        tight_loop_contents();              // Conversão em andamento termina
+    }
+    for (int i = 0; i < 2; i++) {
+        // Abortar com o IRQ habilitado gera um IRQ espúrio (RP2040-E13)
+        dma_channel_set_irq1_enabled(dma_chan[i], false);
+        dma_channel_abort(dma_chan[i]);
+        dma_channel_acknowledge_irq1(dma_chan[i]);
+        dma_channel_set_irq1_enabled(dma_chan[i], true);
+    }
+    adc_fifo_drain();
+    adc_hw->fcs |= ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS;  // Bits limpos por escrita de 1
+}
+
+// Recomeça do início do round-robin, com os dois blocos e os acumuladores vazios
+static void __not_in_flash_func(acquisition_rearm)(void) {
+    rr_pos = 0;
+    for (uint32_t input = 0; input < ADC_SAMPLER_MAX_INPUTS; input++) {
+        acc_sum[input] = 0;
+        acc_count[input] = 0;
+    }
+    adc_select_input(rr_inputs[0]);
+    for (int i = 0; i < 2; i++) {
+        dma_channel_set_write_addr(dma_chan[i], adc_blocks[i], false);
+        dma_channel_set_trans_count(dma_chan[i], ADC_SAMPLER_BLOCK_SAMPLES, false);
+    }
+    dma_channel_start(dma_chan[0]);
+    adc_run(true);
+}
+
+// IRQ do DMA: processa o bloco recém-concluído e rearma o canal
+static void __not_in_flash_func(adc_sampler_dma_irq)(void) {
+    PROF_SCOPE(PROF_ADC_IRQ);
+    bool done[2];
+    for (int i = 0; i < 2; i++) {
+        done[i] = dma_chan[i] >= 0 && dma_channel_get_irq1_status(dma_chan[i]);
+    }
+    if (!done[0] && !done[1]) {
+        return;                             // IRQ de outro canal (handler compartilhado)
+    }
+
+    // Amostras perdidas: os dois blocos pendentes (o mais antigo já está
+    // sendo sobrescrito) ou o FIFO do ADC estourou. Os blocos podem estar
+    // misturados, fora de ordem, e o round-robin fora de fase: nada é
+    // publicado e a aquisição recomeça da primeira entrada.
+    bool lost = false;
+    if (done[0] && done[1]) {
+        stats.dma_overruns++;
+        lost = true;
+    }
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        stats.fifo_overruns++;
+        lost = true;
+    }
+    if (lost) {
+        acquisition_halt();
+        acquisition_rearm();
+        return;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (!done[i]) continue;
+        dma_channel_acknowledge_irq1(dma_chan[i]);
+        // Contagem é recarregada no próximo disparo e o anel já devolveu o
+        // endereço de escrita ao início do bloco: nada a rearmar
+        process_block(adc_blocks[i]);
+    }
+}
+
+void adc_sampler_init(uint32_t input, uint32_t sample_rate_hz, uint32_t oversample) {
+    const adc_sampler_config_t single = {
+        .input_mask = 1u << input,
+        .mux_input = ADC_SAMPLER_NO_MUX,
+    };
+    adc_sampler_init_config(&single, sample_rate_hz, oversample);
+}
+
+void adc_sampler_init_config(const adc_sampler_config_t *cfg, uint32_t sample_rate_hz,
+                             uint32_t oversample) {
+    if (oversample > ADC_SAMPLER_MAX_OVERSAMPLE) {
+        oversample = ADC_SAMPLER_MAX_OVERSAMPLE;
+    }
+    oversample_log2 = oversample;
+    config = *cfg;
+    rr_count = 0;
+    rr_pos = 0;
+    blocks_done = 0;
+    paused = false;
+    mux_valid_from = 0;
+    for (uint32_t input = 0; input < ADC_SAMPLER_MAX_INPUTS; input++) {
+        acc_sum[input] = 0;
+        acc_count[input] = 0;
+        if (config.input_mask & (1u << input)) {
+            rr_inputs[rr_count++] = (uint8_t)input;
+            adc_gpio_init(26 + input);      // ADC0..ADC3 = GPIO 26..29
+        }
+    }
+
+    // --- Multiplexador: seleção em GPIOs consecutivos, começa no canal 0 ---
+    if (config.mux_input != ADC_SAMPLER_NO_MUX) {
+        uint32_t mask = ((1u << ADC_SAMPLER_MUX_SELECT_BITS) - 1) << config.mux_select_gpio;
+        gpio_init_mask(mask);
+        gpio_set_dir_out_masked(mask);
+        mux_select(0);
+    }
+
+    // --- ADC em free-running, enviando cada amostra ao FIFO ---
+    adc_select_input(rr_inputs[0]);
+    adc_set_round_robin(rr_count > 1 ? config.input_mask : 0);
+    adc_fifo_setup(
+        true,    // Habilita o FIFO
+        true,    // Gera DREQ para o DMA
+        1,       // DREQ com 1 amostra disponível
+        true,    // Bit 15 sinaliza erro de conversão
+        false    // Amostras de 12 bits (sem deslocamento para 8 bits)
+    );
+    // Período = (1 + div) ciclos de 48 MHz; mínimo de 96 ciclos (500 ksps)
+    adc_set_clkdiv(48000000.0f / (float)sample_rate_hz - 1.0f);
+
+    // --- Dois canais DMA encadeados entre si (ping-pong) ---
+    for (int i = 0; i < 2; i++) {
+        dma_chan[i] = dma_claim_unused_channel(true);
+    }
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config c = dma_channel_get_default_config(dma_chan[i]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, false);   // Sempre lê o FIFO do ADC
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_ring(&c, true, ADC_BLOCK_RING_BITS);
+        channel_config_set_dreq(&c, DREQ_ADC);
+        channel_config_set_chain_to(&c, dma_chan[i ^ 1]);
+        dma_channel_configure(dma_chan[i], &c, adc_blocks[i], &adc_hw->fifo,
+                              ADC_SAMPLER_BLOCK_SAMPLES, false);
+        dma_channel_set_irq1_enabled(dma_chan[i], true);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_1, adc_sampler_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    adc_fifo_drain();
+    dma_channel_start(dma_chan[0]);
+    adc_run(true);
+}
+
+void adc_sampler_stop(void) {
+    paused = false;
+    adc_run(false);
+    adc_set_round_robin(0);
+    for (int i = 0; i < 2; i++) {
+        if (dma_chan[i] < 0) continue;
+        dma_channel_set_irq1_enabled(dma_chan[i], false);
+        dma_channel_abort(dma_chan[i]);
+        dma_channel_unclaim(dma_chan[i]);
+        dma_chan[i] = -1;
+    }
+    irq_remove_handler(DMA_IRQ_1, adc_sampler_dma_irq);
+    adc_fifo_drain();
+    adc_fifo_setup(false, false, 0, false, false);
+}
+
+void adc_sampler_pause(void) {
+    if (dma_chan[0] < 0 || paused) {
+        return;
+    }
+    uint32_t irq_state = save_and_disable_interrupts();
+    acquisition_halt();
+    paused = true;
+    restore_interrupts(irq_state);
+}
+
+void adc_sampler_resume(void) {
+    if (!paused) {
+        return;
+    }
+    uint32_t irq_state = save_and_disable_interrupts();
+    acquisition_rearm();
+    paused = false;
+    restore_interrupts(irq_state);
+}
+
+void adc_sampler_set_mux_scan(uint32_t channel_mask) {
+    mux_scan = channel_mask;
+}
+
+bool adc_sampler_poll(adc_sampler_reading_t *out) {
+    uint32_t tail = queue_tail;
+    if (tail == queue_head) {
+        return false;
+    }
+    *out = queue[tail % ADC_SAMPLER_QUEUE_LEN];
+    __compiler_memory_barrier();
+    queue_tail = tail + 1;
+    return true;
+}
+
+bool adc_sampler_get_latest(adc_sampler_reading_t *out) {
+    bool found = false;
+    while (adc_sampler_poll(out)) {
+        found = true;
+    }
+    return found;
+}
+
+void adc_sampler_get_stats(adc_sampler_stats_t *out) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    out->readings = stats.readings;
+    out->dropped_readings = stats.dropped_readings;
+    out->conversion_errors = stats.conversion_errors;
+    out->fifo_overruns = stats.fifo_overruns;
+    out->dma_overruns = stats.dma_overruns;
+    restore_interrupts(irq_state);
+}
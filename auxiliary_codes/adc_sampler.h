@@ -0,0 +1,74 @@
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Configurações da aquisição
+#define ADC_SAMPLER_BLOCK_SAMPLES 256      // Amostras por meio-buffer do DMA (um IRQ por bloco)
+#define ADC_SAMPLER_QUEUE_LEN 16           // Leituras decimadas aguardando o consumidor
+#define ADC_SAMPLER_DEFAULT_RATE_HZ 25600  // Taxa bruta do ADC em modo free-running
+#define ADC_SAMPLER_DEFAULT_OVERSAMPLE 8   // log2 da sobreamostragem: 256x → 16 bits efetivos
+#define ADC_SAMPLER_MAX_OVERSAMPLE 16      // 2^16 amostras de 12 bits ainda cabem em 32 bits
+#define ADC_SAMPLER_MAX_INPUTS 3           // ADC0..ADC2 (ADC3 mede VSYS no Pico)
+#define ADC_SAMPLER_NO_MUX 0xFF            // Entrada sem multiplexador / leitura direta
+#define ADC_SAMPLER_MUX_SELECT_BITS 3      // 74HC4051: 8 canais, seleção S0..S2
+
+// Leitura decimada entregue ao consumidor
+typedef struct {
+    uint32_t value;          // Soma sobreamostrada, com (12 + oversample/2) bits efetivos
+    uint16_t mean;           // Média em 12 bits (mesma escala de adc_read())
+    uint8_t bits;            // Resolução efetiva de 'value'
+    uint8_t input;           // Entrada do ADC (0..2)
+    uint8_t mux;             // Canal do multiplexador externo (ADC_SAMPLER_NO_MUX = direto)
+    uint64_t timestamp_us;   // Instante em que a última amostra do bloco chegou
+} adc_sampler_reading_t;
+
+// Várias entradas em round-robin (o ADC alterna sozinho a cada conversão) e,
+// opcionalmente, um multiplexador analógico externo numa delas. Após trocar
+// o canal do multiplexador, as amostras dessa entrada são descartadas até o
+// fim do bloco seguinte (o canal muda no meio de um bloco já em andamento).
+typedef struct {
+    uint32_t input_mask;     // Bit n = ADCn no round-robin
+    uint8_t mux_input;       // Entrada ligada ao multiplexador (ADC_SAMPLER_NO_MUX = nenhum)
+    uint8_t mux_channels;    // Canais usados do multiplexador (1..8)
+    uint8_t mux_select_gpio; // GPIO de S0; S1 e S2 nos dois seguintes
+} adc_sampler_config_t;
+
+// Contadores de perdas da aquisição. Num estouro (FIFO ou DMA) as amostras
+// pendentes são descartadas e a aquisição recomeça da primeira entrada:
+// nenhuma leitura mistura blocos nem sai atribuída à entrada errada.
+typedef struct {
+    uint32_t readings;           // Leituras decimadas produzidas
+    uint32_t dropped_readings;   // Leituras descartadas porque a fila estava cheia
+    uint32_t conversion_errors;  // Amostras com bit de erro do ADC (descartadas)
+    uint32_t fifo_overruns;      // FIFO do ADC estourou (DMA não acompanhou)
+    uint32_t dma_overruns;       // Bloco reescrito antes de ser processado
+} adc_sampler_stats_t;
+
+// Inicia o ADC em free-running no canal 'input', com DMA em ping-pong
+void adc_sampler_init(uint32_t input, uint32_t sample_rate_hz, uint32_t oversample_log2);
+
+// Mesmo, com várias entradas e multiplexador. 'sample_rate_hz' é a taxa
+// total: cada entrada recebe sample_rate_hz / número de entradas.
+void adc_sampler_init_config(const adc_sampler_config_t *config, uint32_t sample_rate_hz,
+                             uint32_t oversample_log2);
+void adc_sampler_stop(void);
+
+// Para o ADC e o DMA sem soltar os canais, para uma gravação na flash: com
+// o outro núcleo parado e os IRQs desligados ninguém processa os blocos.
+// resume descarta o que estava pela metade e recomeça da primeira entrada.
+// Sem efeito se a aquisição não estiver rodando (ou já pausada).
+void adc_sampler_pause(void);
+void adc_sampler_resume(void);
+
+// Canais do multiplexador percorridos (bit n = canal n; 0 = todos). Permite
+// ler mais vezes as zonas irrigando, para desligar a bomba no limiar.
+void adc_sampler_set_mux_scan(uint32_t channel_mask);
+
+// API não bloqueante
+bool adc_sampler_poll(adc_sampler_reading_t *out);        // Próxima leitura em ordem (FIFO)
+bool adc_sampler_get_latest(adc_sampler_reading_t *out);  // Descarta as antigas, entrega a mais recente (uma entrada)
+void adc_sampler_get_stats(adc_sampler_stats_t *stats);
+
+#endif // ADC_SAMPLER_H
@@ -0,0 +1,198 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "dose_control.h"                   // Dosagem adaptativa
+
+#define FILTER_Q 4                          // Água filtrada em Q4
+#define FILTER_DIV 8                        // Média exponencial: 1/8 por leitura (~80 ms a 100 Hz)
+#define FILTER_GAP_US 200000                // Leituras espaçadas (baixo consumo): sem filtro
+#define GAIN_RANGE 8                        // Ganho estimado fica em gain0/8 .. gain0*8
+#define DELAY_MIN_MS 500
+#define DELAY_MAX_MS 60000
+#define MIN_RESPONSE 4                      // Resposta < 4 × settle_cml não estima o ganho
+
+static uint32_t clamp_u32(uint32_t v, uint32_t lo, uint32_t hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+static int32_t clamp_i32(int32_t v, int32_t lo, int32_t hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+void dose_control_init(dose_control_t *dc, const dose_config_t *cfg) {
+    *dc = (dose_control_t){
+        .cfg = *cfg,
+        .gain_q8 = cfg->gain0_q8,
+        .delay_ms = cfg->delay0_ms,
+    };
+}
+
+// ===== LEITURAS =====
+uint16_t dose_control_water(const dose_control_t *dc) {
+    int32_t w = (dc->water_q4 + (1 << (FILTER_Q - 1))) >> FILTER_Q;
+    return (uint16_t)(w < 0 ? 0 : w);
+}
+
+void dose_control_observe(dose_control_t *dc, uint16_t water_cml, uint64_t now_us) {
+    // Filtro curto contra o ruído; depois de um intervalo longo, recomeça
+    int32_t w = (int32_t)water_cml << FILTER_Q;
+    if (dc->water_us == 0 || now_us - dc->water_us > FILTER_GAP_US) {
+        dc->water_q4 = w;
+    } else {
+        dc->water_q4 += (w - dc->water_q4) / FILTER_DIV;
+    }
+    dc->water_us = now_us ? now_us : 1;
+    uint16_t water = dose_control_water(dc);
+
+    if (dc->in_cycle && water > dc->cycle.peak_cml) {
+        dc->cycle.peak_cml = water;
+    }
+    // Área da resposta desde o início da dose (estimativa do atraso)
+    if (dc->area_us) {
+        dc->area += (int64_t)((int32_t)water - dc->dose_start_cml) * (int64_t)(now_us - dc->area_us);
+        dc->area_us = now_us;
+    }
+    // Encharcando: marca cada subida acima do ruído
+    if (dc->dose_end_us && water >= dc->soak_peak_cml + dc->cfg.settle_cml) {
+        dc->soak_peak_cml = water;
+        dc->soak_rise_us = now_us;
+    }
+}
+
+// ===== DECISÕES =====
+uint32_t dose_control_next_dose_ms(dose_control_t *dc) {
+    const dose_config_t *cfg = &dc->cfg;
+    int32_t error = (int32_t)cfg->target_cml - dose_control_water(dc);
+    int32_t u = error;
+    if (cfg->mode == DOSE_MODE_PI) {
+        u = error * cfg->kp_q8 / 256 + dc->integral_cml;
+    }
+    // Água desejada → tempo de bomba pelo ganho estimado
+    int64_t ms = (int64_t)u * 256000 / (int64_t)dc->gain_q8;
+    dc->saturated = 0;
+    if (ms < (int64_t)cfg->min_dose_ms) {
+        ms = cfg->min_dose_ms;
+        dc->saturated = -1;
+    } else if (ms > (int64_t)cfg->max_dose_ms) {
+        ms = cfg->max_dose_ms;
+        dc->saturated = 1;
+    }
+    return (uint32_t)ms;
+}
+
+bool dose_control_settled(const dose_control_t *dc, uint64_t now_us) {
+    uint32_t hold_ms = dc->delay_ms > dc->cfg.min_soak_ms ? dc->delay_ms : dc->cfg.min_soak_ms;
+    return dc->dose_end_us != 0 && now_us - dc->soak_rise_us >= hold_ms * 1000ull;
+}
+
+bool dose_control_on_target(const dose_control_t *dc) {
+    return dose_control_water(dc) + dc->cfg.tolerance_cml >= dc->cfg.target_cml;
+}
+
+// ===== TRANSIÇÕES =====
+void dose_control_dose_started(dose_control_t *dc, uint64_t now_us) {
+    uint16_t water = dose_control_water(dc);
+    if (!dc->in_cycle) {
+        dc->in_cycle = true;
+        dc->cycle_start_us = now_us;
+        dc->cycle = (dose_cycle_report_t){
+            .start_cml = water,
+            .peak_cml = water,
+            .target_cml = dc->cfg.target_cml,
+        };
+    }
+    dc->cycle.doses++;
+    dc->dose_start_cml = water;
+    dc->dose_start_us = now_us;
+    dc->dose_end_us = 0;
+    dc->area = 0;
+    dc->area_us = now_us;
+}
+
+void dose_control_dose_ended(dose_control_t *dc, uint64_t now_us) {
+    dc->dose_ms = (uint32_t)((now_us - dc->dose_start_us) / 1000);
+    dc->cycle.pump_ms += dc->dose_ms;
+    dc->dose_end_us = now_us;
+    dc->soak_peak_cml = dose_control_water(dc);
+    dc->soak_rise_us = now_us;
+}
+
+// Resposta assentada de uma dose: ganho = água / tempo de bomba; atraso =
+// tempo médio da resposta (T − área/Δ) contado do meio da dose
+static void update_model(dose_control_t *dc, uint64_t now_us) {
+    const dose_config_t *cfg = &dc->cfg;
+    int32_t delta = (int32_t)dose_control_water(dc) - dc->dose_start_cml;
+    if (dc->dose_ms < cfg->min_dose_ms) {
+        return;
+    }
+    uint32_t lo = cfg->gain0_q8 / GAIN_RANGE, hi = cfg->gain0_q8 * GAIN_RANGE;
+    if (delta < (int32_t)cfg->settle_cml) {
+        // Bomba sem efeito (reservatório vazio?): doses mais longas até bloquear
+        dc->gain_q8 = clamp_u32(dc->gain_q8 / 2, lo, hi);
+        return;
+    }
+    if (delta < MIN_RESPONSE * (int32_t)cfg->settle_cml) {
+        return;                             // Resposta pequena demais perto do ruído
+    }
+    uint32_t measured = (uint32_t)((int64_t)delta * 256000 / dc->dose_ms);
+    dc->gain_q8 = clamp_u32((dc->gain_q8 + measured) / 2, lo, hi);
+
+    int64_t mean_us = (int64_t)(now_us - dc->dose_start_us) - dc->area / delta;
+    int64_t delay_ms = mean_us / 1000 - dc->dose_ms / 2;
+    if (delay_ms > 0) {
+        uint32_t d = clamp_u32((uint32_t)(delay_ms < DELAY_MAX_MS ? delay_ms : DELAY_MAX_MS),
+                               DELAY_MIN_MS, DELAY_MAX_MS);
+        dc->delay_ms = (dc->delay_ms + d) / 2;
+    }
+}
+
+// Resposta interrompida (encharcou antes de assentar): o ganho é pelo menos
+// o já observado, e a próxima dose sai mais curta
+static void raise_gain(dose_control_t *dc) {
+    const dose_config_t *cfg = &dc->cfg;
+    int32_t delta = (int32_t)dose_control_water(dc) - dc->dose_start_cml;
+    if (dc->dose_ms < cfg->min_dose_ms || delta < MIN_RESPONSE * (int32_t)cfg->settle_cml) {
+        return;
+    }
+    uint32_t measured = (uint32_t)((int64_t)delta * 256000 / dc->dose_ms);
+    if (measured > dc->gain_q8) {
+        dc->gain_q8 = clamp_u32(measured, cfg->gain0_q8 / GAIN_RANGE, cfg->gain0_q8 * GAIN_RANGE);
+    }
+}
+
+void dose_control_soak_ended(dose_control_t *dc, bool settled, uint64_t now_us) {
+    const dose_config_t *cfg = &dc->cfg;
+    if (dc->area_us && !settled) {
+        raise_gain(dc);
+    } else if (dc->area_us) {
+        update_model(dc, now_us);
+        // PI com anti-windup: não integra quando a dose saturou no mesmo sentido do erro
+        int32_t error = (int32_t)cfg->target_cml - dose_control_water(dc);
+        if (cfg->mode == DOSE_MODE_PI && !(dc->saturated > 0 && error > 0) &&
+            !(dc->saturated < 0 && error < 0)) {
+            int32_t limit = (int32_t)((int64_t)cfg->max_dose_ms * dc->gain_q8 / 256000);
+            dc->integral_cml = clamp_i32(dc->integral_cml + error * cfg->ki_q8 / 256, -limit, limit);
+        }
+    }
+    dc->area_us = 0;
+    dc->dose_end_us = 0;
+}
+
+void dose_control_cycle_ended(dose_control_t *dc, bool aborted, uint64_t now_us) {
+    if (aborted && dc->area_us && dc->dose_end_us) {
+        raise_gain(dc);                     // Encharcou durante a dose
+    }
+    dc->area_us = 0;
+    dc->dose_end_us = 0;
+    if (!dc->in_cycle) {
+        return;
+    }
+    dc->in_cycle = false;
+    dc->cycle.end_cml = dose_control_water(dc);
+    dc->cycle.aborted = aborted;
+    dc->cycle.settle_ms = (uint32_t)((now_us - dc->cycle_start_us) / 1000);
+    dc->cycle.gain_q8 = dc->gain_q8;
+    dc->cycle.delay_ms = dc->delay_ms;
+    dc->cycle_done = true;
+    if (aborted) {
+        dc->integral_cml = 0;               // Bloqueio: o erro acumulado não vale mais
+    }
+}
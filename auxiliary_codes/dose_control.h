@@ -0,0 +1,100 @@
+#ifndef DOSE_CONTROL_H
+#define DOSE_CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Dosagem adaptativa de uma zona: a duração de cada dose sai da distância
+// até o alvo e de um modelo do vaso estimado a cada dose:
+// - ganho: água percebida pelo sensor por segundo de bomba
+// - atraso: tempo médio da dose até a água chegar ao sensor (método das áreas)
+// O encharcamento dura até a leitura parar de subir, e não um tempo fixo.
+// Lógica pura em inteiros: água em centésimos de mL, tempos em ms.
+
+typedef enum {
+    DOSE_MODE_MODEL = 0,        // Dose = erro / ganho estimado (corrige tudo de uma vez)
+    DOSE_MODE_PI,               // PI discreto, uma iteração por dose, normalizado pelo ganho
+} dose_mode_t;
+
+typedef struct {
+    uint8_t mode;               // dose_mode_t
+    uint16_t target_cml;        // Alvo do ciclo, dentro da faixa adequada
+    uint16_t tolerance_cml;     // O ciclo termina a menos disso do alvo
+    uint16_t settle_cml;        // Subida menor que isso é ruído: a leitura assentou
+    uint32_t min_dose_ms;       // Dose mais curta que a bomba faz direito
+    uint32_t max_dose_ms;
+    uint32_t min_soak_ms;       // Espera mínima sem subir após cada dose
+    uint16_t kp_q8;             // PI: fração do erro corrigida por dose (Q8: 256 = 1.0)
+    uint16_t ki_q8;             // PI: fração do erro residual acumulada por dose
+    uint32_t gain0_q8;          // Ganho inicial (centésimos de mL por s de bomba, Q8)
+    uint32_t delay0_ms;         // Atraso inicial
+} dose_config_t;
+
+// Resumo de um ciclo de irrigação (solo seco → alvo)
+typedef struct {
+    uint16_t start_cml;         // Água no início
+    uint16_t end_cml;           // Água ao fim (assentada, salvo se bloqueou)
+    uint16_t peak_cml;          // Maior leitura filtrada do ciclo (sobressinal)
+    uint16_t target_cml;
+    uint8_t doses;
+    bool aborted;               // Terminou bloqueado (encharcado ou doses demais)
+    uint32_t pump_ms;           // Bomba ligada no ciclo (água usada = vazão × tempo)
+    uint32_t settle_ms;         // Início do ciclo → leitura assentada
+    uint32_t gain_q8;           // Modelo ao fim do ciclo
+    uint32_t delay_ms;
+} dose_cycle_report_t;
+
+typedef struct {
+    dose_config_t cfg;
+    // --- Modelo estimado e PI ---
+    uint32_t gain_q8;
+    uint32_t delay_ms;
+    int32_t integral_cml;
+    int8_t saturated;           // Última dose limitada: +1 no máximo, -1 no mínimo
+    // --- Leitura filtrada ---
+    int32_t water_q4;           // Média móvel exponencial (Q4)
+    uint64_t water_us;          // Última leitura (0 = nenhuma)
+    // --- Dose e encharcamento em andamento ---
+    uint16_t dose_start_cml;
+    uint64_t dose_start_us;
+    uint32_t dose_ms;           // Duração real da última dose
+    uint64_t dose_end_us;
+    uint16_t soak_peak_cml;
+    uint64_t soak_rise_us;      // Última subida de 'settle_cml' acima do pico
+    int64_t area;               // ∫(água − água no início da dose) dt, cml·µs
+    uint64_t area_us;           // Último instante integrado (0 = sem dose)
+    // --- Ciclo ---
+    bool in_cycle;
+    uint64_t cycle_start_us;
+    dose_cycle_report_t cycle;
+    bool cycle_done;            // 'cycle' completo esperando quem o relate
+} dose_control_t;
+
+void dose_control_init(dose_control_t *dc, const dose_config_t *cfg);
+
+// Nova leitura da zona, em qualquer estado
+void dose_control_observe(dose_control_t *dc, uint16_t water_cml, uint64_t now_us);
+
+// Água filtrada
+uint16_t dose_control_water(const dose_control_t *dc);
+
+// Duração da próxima dose para chegar ao alvo (limitada a min..max)
+uint32_t dose_control_next_dose_ms(dose_control_t *dc);
+
+// Encharcamento concluído: a leitura não sobe há um atraso estimado
+bool dose_control_settled(const dose_control_t *dc, uint64_t now_us);
+
+// Leitura perto do alvo (ou acima): o ciclo pode terminar
+bool dose_control_on_target(const dose_control_t *dc);
+
+// --- Transições da máquina de estados (plant_control) ---
+void dose_control_dose_started(dose_control_t *dc, uint64_t now_us);
+void dose_control_dose_ended(dose_control_t *dc, uint64_t now_us);
+
+// Fim do encharcamento: com a leitura assentada, atualiza o modelo e o PI
+void dose_control_soak_ended(dose_control_t *dc, bool settled, uint64_t now_us);
+
+// Ciclo terminou (ocioso ou bloqueado): prepara o resumo
+void dose_control_cycle_ended(dose_control_t *dc, bool aborted, uint64_t now_us);
+
+#endif // DOSE_CONTROL_H
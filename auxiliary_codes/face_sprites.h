@@ -0,0 +1,18 @@
+#ifndef FACE_SPRITES_H
+#define FACE_SPRITES_H
+
+#include "oled_ssd1306.h"
+
+// Sprites desenhados em tempo de build pelo próprio driver (tools/gen_face_sprites)
+// (64 colunas x 8 páginas, posicionados na coluna FACE_SPRITE_X)
+#define FACE_SPRITE_X 32
+
+extern const oled_sprite_t face_happy;
+extern const oled_sprite_t face_happy_half;
+extern const oled_sprite_t face_happy_closed;
+extern const oled_sprite_t face_sad;
+extern const oled_sprite_t face_sad_tear1;
+extern const oled_sprite_t face_sad_tear2;
+extern const oled_sprite_t face_sad_tear3;
+
+#endif // FACE_SPRITES_H
@@ -0,0 +1,242 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "flash_log.h"                      // Histórico persistente
+#include "flash_store.h"                    // Região da flash (ou simulada)
+#include "hal.h"                            // Tempo gasto com a flash
+#include <string.h>
+
+#define PAGES_PER_SECTOR (FLASH_STORE_SECTOR_SIZE / FLASH_LOG_PAGE_SIZE)
+#define US_PER_TICK (FLASH_LOG_TICK_MS * 1000u)
+
+// ===== ESTADO =====
+static uint32_t region_pages;               // 0 = histórico desativado
+static uint32_t write_page;                 // Próxima página da região a gravar
+static uint32_t next_seq;
+static uint16_t boot;
+
+// Duas páginas em RAM: uma enchendo e outra cheia esperando a gravação
+static uint8_t pages[2][FLASH_LOG_PAGE_SIZE];
+static flash_log_writer_t writer;
+static uint8_t filling;
+static bool pending;                        // pages[filling ^ 1] aguarda gravação
+static uint64_t page_started_us;
+
+// Média de cada zona até a próxima leitura gravada
+static uint64_t reading_sum[FLASH_LOG_MAX_ZONES];
+static uint32_t reading_count[FLASH_LOG_MAX_ZONES];
+static uint64_t next_reading_us[FLASH_LOG_MAX_ZONES];
+static uint64_t reading_interval_us;
+
+static flash_log_stats_t stats;
+
+static const flash_log_page_header_t *header(const uint8_t *page) {
+    return (const flash_log_page_header_t *)page;
+}
+
+// ===== INICIALIZAÇÃO =====
+bool flash_log_init(uint32_t zones) {
+    uint32_t size = flash_store_size();
+    region_pages = (size < FLASH_STORE_LOG_SIZE ? size : FLASH_STORE_LOG_SIZE) / FLASH_LOG_PAGE_SIZE;
+    reading_interval_us = FLASH_LOG_READING_MS * 1000ull * (zones > 2 ? zones / 2 : 1);
+
+    // A maior sequência válida é a última página gravada
+    bool found = false;
+    uint32_t newest = 0;
+    for (uint32_t i = 0; i < region_pages; i++) {
+        const uint8_t *p = flash_store_read(i * FLASH_LOG_PAGE_SIZE);
+        if (flash_log_page_valid(p) &&
+            (!found || (int32_t)(header(p)->seq - next_seq) >= 0)) {
+            found = true;
+            newest = i;
+            next_seq = header(p)->seq;
+            boot = header(p)->boot;
+        }
+    }
+    if (found) {
+        write_page = (newest + 1) % region_pages;
+        next_seq++;
+        boot++;
+    }
+
+    filling = 0;
+    pending = false;
+    flash_log_page_begin(&writer, pages[filling], boot);
+    return region_pages != 0;
+}
+
+uint16_t flash_log_boot(void) {
+    return boot;
+}
+
+// ===== REGISTROS =====
+static void append(const flash_log_record_t *rec, uint64_t now_us) {
+    if (region_pages == 0) {
+        return;
+    }
+    if (header(writer.page)->count == 0) {
+        page_started_us = now_us;
+    }
+    if (flash_log_page_append(&writer, rec)) {
+        return;
+    }
+    // Página cheia: vira pendente, se a anterior já foi gravada
+    if (pending) {
+        stats.records_dropped++;
+        return;
+    }
+    pending = true;
+    filling ^= 1;
+    flash_log_page_begin(&writer, pages[filling], boot);
+    page_started_us = now_us;
+    flash_log_page_append(&writer, rec);
+}
+
+void flash_log_sample(uint64_t now_us, uint8_t zone, uint16_t value) {
+    zone &= FLASH_LOG_MAX_ZONES - 1;
+    reading_sum[zone] += value;
+    reading_count[zone]++;
+    if (now_us < next_reading_us[zone]) {
+        return;
+    }
+    flash_log_record_t rec = {
+        .type = FLASH_LOG_READING,
+        .zone = zone,
+        .ticks = (uint32_t)(now_us / US_PER_TICK),
+        .value = (uint16_t)(reading_sum[zone] / reading_count[zone]),
+    };
+    append(&rec, now_us);
+    reading_sum[zone] = 0;
+    reading_count[zone] = 0;
+    next_reading_us[zone] = now_us + reading_interval_us;
+}
+
+void flash_log_event(uint64_t now_us, uint8_t zone, uint8_t prev_state, uint8_t state,
+                     uint8_t reason) {
+    flash_log_record_t rec = {
+        .type = FLASH_LOG_EVENT,
+        .zone = zone,
+        .ticks = (uint32_t)(now_us / US_PER_TICK),
+        .prev_state = prev_state,
+        .state = state,
+        .reason = reason,
+    };
+    append(&rec, now_us);
+}
+
+// ===== GRAVAÇÃO =====
+static bool sector_blank(uint32_t first_page) {
+    for (uint32_t i = 0; i < PAGES_PER_SECTOR; i++) {
+        if (!flash_log_page_blank(flash_store_read((first_page + i) * FLASH_LOG_PAGE_SIZE))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Grava na próxima página livre. Ao entrar num setor, apaga-o (descarta o
+// mais antigo); páginas não apagadas no meio de um setor são puladas.
+static bool write_page_to_flash(uint8_t *page) {
+    for (uint32_t tries = 0; tries < region_pages; tries++) {
+        uint32_t offset = write_page * FLASH_LOG_PAGE_SIZE;
+        if (write_page % PAGES_PER_SECTOR == 0 && !sector_blank(write_page)) {
+            if (!flash_store_erase(offset)) {
+                stats.write_errors++;
+                return false;                   // Tenta de novo no próximo poll
+            }
+            stats.sectors_erased++;
+        }
+        if (!flash_log_page_blank(flash_store_read(offset))) {
+            stats.pages_skipped++;
+            write_page = (write_page + 1) % region_pages;
+            continue;
+        }
+
+        flash_log_page_seal(page, next_seq);
+        if (!flash_store_program(offset, page)) {
+            stats.write_errors++;
+            return false;
+        }
+        write_page = (write_page + 1) % region_pages;
+        if (memcmp(flash_store_read(offset), page, FLASH_LOG_PAGE_SIZE) != 0) {
+            stats.write_errors++;               // Célula gasta: usa a próxima página
+            continue;
+        }
+        next_seq++;
+        stats.pages_written++;
+        return true;
+    }
+    return false;
+}
+
+bool flash_log_poll(uint64_t now_us, bool allow_write) {
+    if (region_pages == 0) {
+        return false;
+    }
+    // Página parcial antiga: limita o que se perde numa queda de energia
+    if (!pending && header(writer.page)->count > 0 &&
+        now_us - page_started_us >= FLASH_LOG_MAX_AGE_MS * 1000ull) {
+        pending = true;
+        filling ^= 1;
+        flash_log_page_begin(&writer, pages[filling], boot);
+    }
+    if (!pending || !allow_write) {
+        return false;
+    }
+
+    uint64_t start = hal_time_us();
+    bool ok = write_page_to_flash(pages[filling ^ 1]);
+    uint32_t elapsed = (uint32_t)(hal_time_us() - start);
+    if (elapsed > stats.write_us_max) {
+        stats.write_us_max = elapsed;
+    }
+    if (ok) {
+        pending = false;
+    }
+    return ok;
+}
+
+bool flash_log_write_pending(void) {
+    return pending;
+}
+
+// ===== DESPEJO =====
+uint32_t flash_log_dump_count(void) {
+    return region_pages + 2;
+}
+
+bool flash_log_dump_page(uint32_t n, uint8_t *out, size_t *len) {
+    if (region_pages == 0) {
+        return false;
+    }
+    if (n < region_pages) {
+        // Começa no setor seguinte ao atual: o mais antigo do anel
+        uint32_t first = (write_page / PAGES_PER_SECTOR + 1) * PAGES_PER_SECTOR;
+        const uint8_t *p = flash_store_read((first + n) % region_pages * FLASH_LOG_PAGE_SIZE);
+        if (!flash_log_page_valid(p)) {
+            return false;
+        }
+        memcpy(out, p, FLASH_LOG_PAGE_SIZE);
+    } else {
+        // Ainda em RAM: a pendente e depois a que está enchendo, com as
+        // sequências que receberão ao serem gravadas
+        const uint8_t *p;
+        uint32_t seq = next_seq;
+        if (n == region_pages) {
+            if (!pending) return false;
+            p = pages[filling ^ 1];
+        } else {
+            p = writer.page;
+            seq += pending;
+        }
+        if (header(p)->count == 0) {
+            return false;
+        }
+        memcpy(out, p, FLASH_LOG_PAGE_SIZE);
+        flash_log_page_seal(out, seq);
+    }
+    *len = sizeof(flash_log_page_header_t) + header(out)->used;
+    return true;
+}
+
+void flash_log_get_stats(flash_log_stats_t *out) {
+    *out = stats;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "flash_log_format.h"
+
+// Histórico persistente de umidade e irrigação na flash (flash_store.h).
+//
+// - Leituras: média de cada zona a cada FLASH_LOG_READING_MS (mais espaçadas
+//   com muitas zonas), ~4 bytes por registro
+// - Eventos: toda mudança de estado (bomba liga/desliga), 3 bytes
+// - Registros acumulam em RAM e só páginas inteiras vão para a flash
+// - Anel de setores: o mais antigo é apagado ao entrar nele, então cada
+//   setor é apagado uma vez por volta (desgaste uniforme)
+// - Com 512 KiB: ~11 KiB por dia com uma zona (pouco mais de 6 semanas);
+//   com 8 zonas, uma leitura a cada 2 min por zona (~3 semanas)
+//
+// Gravar pausa o outro núcleo (~0,5 ms por página, ~45 ms por setor):
+// quem chama só libera a gravação com a bomba desligada.
+
+#define FLASH_LOG_READING_MS 30000          // Intervalo entre leituras gravadas (até 2 zonas)
+#define FLASH_LOG_MAX_AGE_MS 3600000        // Página parcial vai para a flash após 1 h
+
+typedef struct {
+    uint32_t pages_written;
+    uint32_t sectors_erased;
+    uint32_t pages_skipped;         // Páginas não apagadas (gravação interrompida)
+    uint32_t write_errors;          // Falha ao gravar ou verificação divergente
+    uint32_t records_dropped;       // RAM cheia esperando a bomba desligar
+    uint32_t write_us_max;          // Maior pausa da flash (apagar + gravar)
+} flash_log_stats_t;
+
+// Procura a página mais recente e continua depois dela; false = sem região.
+// Acima de 2 zonas o intervalo das leituras cresce com o número de zonas.
+bool flash_log_init(uint32_t zones);
+
+uint16_t flash_log_boot(void);
+
+// Leitura em 16 bits de uma zona a cada iteração (a média é gravada)
+void flash_log_sample(uint64_t now_us, uint8_t zone, uint16_t value);
+
+// Leitura sobreamostrada de 'bits' bits → 16 bits (formato do histórico)
+static inline uint16_t flash_log_value16(uint32_t value, uint8_t bits) {
+    return bits >= 16 ? (uint16_t)(value >> (bits - 16)) : (uint16_t)(value << (16 - bits));
+}
+
+void flash_log_event(uint64_t now_us, uint8_t zone, uint8_t prev_state, uint8_t state,
+                     uint8_t reason);
+
+// Grava a página pendente, se houver e 'allow_write'; true = gravou
+bool flash_log_poll(uint64_t now_us, bool allow_write);
+
+// Página cheia (ou antiga) esperando a gravação
+bool flash_log_write_pending(void);
+
+// Despejo em ordem cronológica: flash do setor mais antigo ao atual, depois
+// as páginas ainda em RAM. flash_log_dump_page() copia a posição n
+// (0 .. flash_log_dump_count() - 1); false = posição vazia ou inválida.
+uint32_t flash_log_dump_count(void);
+bool flash_log_dump_page(uint32_t n, uint8_t *out, size_t *len);
+
+void flash_log_get_stats(flash_log_stats_t *out);
+
+#endif // FLASH_LOG_H
\ No newline at end of file
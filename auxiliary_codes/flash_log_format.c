@@ -0,0 +1,148 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "flash_log_format.h"               // Formato das páginas do histórico
+#include "telemetry_frame.h"                // telemetry_crc16
+#include <string.h>
+
+#define HEADER_SIZE sizeof(flash_log_page_header_t)
+#define CRC_START 4                         // Depois de magic e crc
+
+// ===== VARINTS =====
+static size_t put_varint(uint8_t *out, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool get_varint(const uint8_t *in, size_t len, size_t *pos, uint32_t *v) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*pos >= len) {
+            return false;
+        }
+        uint8_t b = in[(*pos)++];
+        result |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Diferenças pequenas (positivas ou negativas) viram varints de 1 byte
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// ===== ESCRITA =====
+void flash_log_page_begin(flash_log_writer_t *w, uint8_t *page, uint16_t boot) {
+    memset(page, 0xFF, FLASH_LOG_PAGE_SIZE);  // Sobra da página fica apagada
+    flash_log_page_header_t *hdr = (flash_log_page_header_t *)page;
+    hdr->magic = FLASH_LOG_MAGIC;
+    hdr->boot = boot;
+    hdr->used = 0;
+    hdr->count = 0;
+    w->page = page;
+    w->last_ticks = 0;
+    memset(w->last_value, 0, sizeof(w->last_value));
+}
+
+bool flash_log_page_append(flash_log_writer_t *w, const flash_log_record_t *rec) {
+    flash_log_page_header_t *hdr = (flash_log_page_header_t *)w->page;
+    if (hdr->count == 0) {
+        hdr->t0_ticks = rec->ticks;
+        w->last_ticks = rec->ticks;
+    }
+
+    uint8_t zone = rec->zone & (FLASH_LOG_MAX_ZONES - 1);
+    uint8_t buf[12];
+    size_t n = put_varint(buf, (rec->ticks - w->last_ticks) << 2 | rec->type);
+    if (rec->type == FLASH_LOG_READING) {
+        int32_t delta = (int32_t)rec->value - (int32_t)w->last_value[zone];
+        n += put_varint(&buf[n], zigzag(delta) << 4 | zone);
+    } else {
+        buf[n++] = (uint8_t)(rec->prev_state << 6 | (rec->state & 3) << 4 | (rec->reason & 0xF));
+        buf[n++] = zone;
+    }
+    if (hdr->used + n > FLASH_LOG_BODY_SIZE || hdr->count == 0xFF) {
+        return false;
+    }
+
+    memcpy(&w->page[HEADER_SIZE + hdr->used], buf, n);
+    hdr->used += n;
+    hdr->count++;
+    w->last_ticks = rec->ticks;
+    if (rec->type == FLASH_LOG_READING) {
+        w->last_value[zone] = rec->value;
+    }
+    return true;
+}
+
+void flash_log_page_seal(uint8_t *page, uint32_t seq) {
+    flash_log_page_header_t *hdr = (flash_log_page_header_t *)page;
+    hdr->seq = seq;
+    hdr->crc = telemetry_crc16(&page[CRC_START], HEADER_SIZE - CRC_START + hdr->used);
+}
+
+// ===== LEITURA =====
+bool flash_log_page_valid(const uint8_t *page) {
+    const flash_log_page_header_t *hdr = (const flash_log_page_header_t *)page;
+    return hdr->magic == FLASH_LOG_MAGIC && hdr->used <= FLASH_LOG_BODY_SIZE &&
+           hdr->crc == telemetry_crc16(&page[CRC_START], HEADER_SIZE - CRC_START + hdr->used);
+}
+
+bool flash_log_page_blank(const uint8_t *page) {
+    for (size_t i = 0; i < FLASH_LOG_PAGE_SIZE; i++) {
+        if (page[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void flash_log_reader_init(flash_log_reader_t *r, const uint8_t *page) {
+    const flash_log_page_header_t *hdr = (const flash_log_page_header_t *)page;
+    r->page = page;
+    r->pos = HEADER_SIZE;
+    r->left = hdr->count;
+    r->ticks = hdr->t0_ticks;
+    memset(r->value, 0, sizeof(r->value));
+}
+
+bool flash_log_reader_next(flash_log_reader_t *r, flash_log_record_t *rec) {
+    const flash_log_page_header_t *hdr = (const flash_log_page_header_t *)r->page;
+    size_t end = HEADER_SIZE + hdr->used;
+    uint32_t tag, delta;
+    if (r->left == 0 || !get_varint(r->page, end, &r->pos, &tag)) {
+        return false;
+    }
+    r->ticks += tag >> 2;
+    rec->type = tag & 3;
+    rec->ticks = r->ticks;
+    if (rec->type == FLASH_LOG_READING) {
+        if (!get_varint(r->page, end, &r->pos, &delta)) {
+            return false;
+        }
+        rec->zone = delta & (FLASH_LOG_MAX_ZONES - 1);
+        r->value[rec->zone] = (uint16_t)(r->value[rec->zone] + unzigzag(delta >> 4));
+        rec->value = r->value[rec->zone];
+    } else if (rec->type == FLASH_LOG_EVENT && r->pos + 1 < end) {
+        uint8_t b = r->page[r->pos++];
+        rec->prev_state = b >> 6;
+        rec->state = (b >> 4) & 3;
+        rec->reason = b & 0xF;
+        rec->zone = r->page[r->pos++] & (FLASH_LOG_MAX_ZONES - 1);
+    } else {
+        return false;                       // Tipo desconhecido: para nesta página
+    }
+    r->left--;
+    return true;
+}
\ No newline at end of file
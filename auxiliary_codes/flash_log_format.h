@@ -0,0 +1,81 @@
+#ifndef FLASH_LOG_FORMAT_H
+#define FLASH_LOG_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Formato das páginas do histórico na flash. Portável: usado pelo
+// firmware, pelo simulador e pelo decodificador (tools/telemetry_decode.c).
+//
+// Cada página de 256 bytes é autocontida: cabeçalho com CRC e registros
+// codificados em delta a partir do início da página. Uma página gravada
+// pela metade (queda de energia) falha no CRC e é ignorada sem afetar as
+// demais.
+
+#define FLASH_LOG_PAGE_SIZE 256
+#define FLASH_LOG_MAGIC 0x5A50          // "PZ" (registros com zona)
+#define FLASH_LOG_MAX_ZONES 16
+#define FLASH_LOG_TICK_MS 100           // Resolução do tempo dos registros
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;
+    uint16_t crc;               // CRC-16 do resto do cabeçalho + corpo usado
+    uint32_t seq;               // Ordem de gravação (cresce entre boots)
+    uint32_t t0_ticks;          // Instante do primeiro registro desde o boot
+    uint16_t boot;              // Contador de boots
+    uint8_t used;               // Bytes usados do corpo
+    uint8_t count;              // Registros na página
+} flash_log_page_header_t;
+
+#define FLASH_LOG_BODY_SIZE (FLASH_LOG_PAGE_SIZE - sizeof(flash_log_page_header_t))
+
+// Registro: varint (dt << 2 | tipo), seguido de
+//   FLASH_LOG_READING: varint (zigzag (leitura - anterior da zona na página) << 4 | zona)
+//   FLASH_LOG_EVENT:   1 byte (anterior << 6 | estado << 4 | motivo), 1 byte zona
+typedef enum {
+    FLASH_LOG_READING = 0,      // Média da umidade no intervalo (16 bits)
+    FLASH_LOG_EVENT = 1,        // Mudança de estado (liga/desliga a bomba)
+} flash_log_type_t;
+
+typedef struct {
+    uint8_t type;               // flash_log_type_t
+    uint8_t zone;
+    uint32_t ticks;             // FLASH_LOG_TICK_MS desde o boot
+    uint16_t value;             // READING
+    uint8_t prev_state;         // EVENT
+    uint8_t state;
+    uint8_t reason;
+} flash_log_record_t;
+
+// --- Escrita de uma página em RAM ---
+typedef struct {
+    uint8_t *page;
+    uint32_t last_ticks;
+    uint16_t last_value[FLASH_LOG_MAX_ZONES];
+} flash_log_writer_t;
+
+void flash_log_page_begin(flash_log_writer_t *w, uint8_t *page, uint16_t boot);
+
+// false = não cabe: a página está cheia
+bool flash_log_page_append(flash_log_writer_t *w, const flash_log_record_t *rec);
+
+// Fixa a sequência e calcula o CRC (antes de gravar ou despejar)
+void flash_log_page_seal(uint8_t *page, uint32_t seq);
+
+bool flash_log_page_valid(const uint8_t *page);
+bool flash_log_page_blank(const uint8_t *page);
+
+// --- Leitura dos registros de uma página válida ---
+typedef struct {
+    const uint8_t *page;
+    size_t pos;
+    uint8_t left;
+    uint32_t ticks;
+    uint16_t value[FLASH_LOG_MAX_ZONES];
+} flash_log_reader_t;
+
+void flash_log_reader_init(flash_log_reader_t *r, const uint8_t *page);
+bool flash_log_reader_next(flash_log_reader_t *r, flash_log_record_t *rec);
+
+#endif // FLASH_LOG_FORMAT_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "flash_store.h"                    // Região do histórico na flash
+#include "pico/stdlib.h"
+#include "pico/flash.h"                     // flash_safe_execute (pausa o outro núcleo)
+#include "hardware/flash.h"                 // Apagamento e gravação da QSPI
+
+// Última parte da flash; o programa ocupa o começo
+#define REGION_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_STORE_SIZE)
+#define SAFE_TIMEOUT_MS 10                  // Espera pelo outro núcleo aceitar a pausa
+
+extern char __flash_binary_end;             // Fim do programa (linker script do SDK)
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *page;                    // NULL = apagar setor
+} flash_op_t;
+
+// Executado com o XIP desligado e o outro núcleo parado
+static void do_flash_op(void *param) {
+    const flash_op_t *op = param;
+    if (op->page) {
+        flash_range_program(REGION_OFFSET + op->offset, op->page, FLASH_STORE_PAGE_SIZE);
+    } else {
+        flash_range_erase(REGION_OFFSET + op->offset, FLASH_STORE_SECTOR_SIZE);
+    }
+}
+
+uint32_t flash_store_size(void) {
+    // Programa grande demais invadiria o histórico: melhor não gravar nada
+    if ((uintptr_t)&__flash_binary_end - XIP_BASE > REGION_OFFSET) {
+        return 0;
+    }
+    return FLASH_STORE_SIZE;
+}
+
+const uint8_t *flash_store_read(uint32_t offset) {
+    return (const uint8_t *)(XIP_BASE + REGION_OFFSET + offset);
+}
+
+bool flash_store_erase(uint32_t offset) {
+    flash_op_t op = {offset, NULL};
+    return flash_safe_execute(do_flash_op, &op, SAFE_TIMEOUT_MS) == PICO_OK;
+}
+
+bool flash_store_program(uint32_t offset, const uint8_t *page) {
+    flash_op_t op = {offset, page};
+    return flash_safe_execute(do_flash_op, &op, SAFE_TIMEOUT_MS) == PICO_OK;
+}
\ No newline at end of file
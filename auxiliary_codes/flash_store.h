@@ -0,0 +1,31 @@
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Região reservada da flash para o histórico e a calibração: QSPI no fim
+// da flash do Pico (flash_store.c) ou um vetor em RAM no simulador
+// (host/flash_store_sim.c).
+// Offsets relativos ao início da região.
+
+#define FLASH_STORE_SIZE (512u * 1024u)     // Semanas de histórico (ver flash_log.h)
+#define FLASH_STORE_SECTOR_SIZE 4096u       // Menor unidade de apagamento
+#define FLASH_STORE_PAGE_SIZE 256u          // Menor unidade de gravação
+
+// Divisão da região: histórico em anel e, no último setor, a calibração
+#define FLASH_STORE_LOG_SIZE (FLASH_STORE_SIZE - FLASH_STORE_SECTOR_SIZE)   // flash_log
+#define FLASH_STORE_CALIB_OFFSET FLASH_STORE_LOG_SIZE                       // soil_calib
+
+// Tamanho utilizável (0 = região sobreposta ao programa: histórico desativado)
+uint32_t flash_store_size(void);
+
+// Leitura direta (mapeada em memória)
+const uint8_t *flash_store_read(uint32_t offset);
+
+// Apaga um setor / grava uma página. Pausam o outro núcleo enquanto a
+// flash está indisponível; false = falhou ou não pôde pausar.
+bool flash_store_erase(uint32_t offset);
+bool flash_store_program(uint32_t offset, const uint8_t *page);
+
+#endif // FLASH_STORE_H
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+
+// Camada mínima de tempo usada pelo código portável (display, controle).
+// No Pico usa o timer do SDK (hal_pico.c); no simulador, um relógio
+// virtual que avança sem esperar (host/hal_host.c).
+
+uint64_t hal_time_us(void);             // Microssegundos desde o boot
+void hal_sleep_us(uint64_t us);
+void hal_sleep_until_us(uint64_t t_us);
+void hal_idle(void);                    // Uma volta de espera ativa
+
+// Espera até 't_us' com o núcleo parado: no Pico, um alarme de hardware do
+// próprio núcleo + WFE. Pode voltar antes (evento do outro núcleo ou outra
+// interrupção); quem chama confere o relógio. UINT64_MAX = só o evento.
+void hal_wait_until_us(uint64_t t_us);
+
+// Contador de ciclos da instrumentação (prof.h). No Pico, o SysTick de cada
+// núcleo no clock da CPU: 24 bits, intervalos de até ~134 ms a 125 MHz.
+// No simulador, nanossegundos do relógio real (custo do código no host).
+void hal_cycles_init(void);             // Chamar em cada núcleo
+uint32_t hal_cycles(void);
+uint32_t hal_cycles_elapsed(uint32_t start);
+uint32_t hal_cycles_hz(void);
+
+#endif // HAL_H
@@ -0,0 +1,69 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "hal.h"                            // Interface de tempo portável
+#include "pico/stdlib.h"                    // Timer e esperas do SDK
+#include "hardware/clocks.h"                // Frequência da CPU
+#include "hardware/timer.h"                 // Alarmes de hardware (espera do escalonador)
+#include "hardware/sync.h"                  // __wfe
+#include "hardware/structs/systick.h"       // Contador de ciclos por núcleo
+
+#define SYSTICK_MASK 0xFFFFFFu              // Contador decrescente de 24 bits
+
+static int wait_alarm[2] = {-1, -1};        // Alarme de hardware de cada núcleo
+
+uint64_t hal_time_us(void) {
+    return time_us_64();
+}
+
+void hal_sleep_us(uint64_t us) {
+    sleep_us(us);
+}
+
+void hal_sleep_until_us(uint64_t t_us) {
+    sleep_until(from_us_since_boot(t_us));
+}
+
+void hal_idle(void) {
+    tight_loop_contents();
+}
+
+// A interrupção do alarme já acorda o WFE
+static void wait_alarm_cb(uint alarm_num) {
+    (void)alarm_num;
+}
+
+void hal_wait_until_us(uint64_t t_us) {
+    if (time_us_64() >= t_us) {
+        return;
+    }
+    // O IRQ do alarme vai para o núcleo que registra o callback
+    uint core = get_core_num();
+    if (wait_alarm[core] < 0) {
+        wait_alarm[core] = hardware_alarm_claim_unused(true);
+        hardware_alarm_set_callback((uint)wait_alarm[core], wait_alarm_cb);
+    }
+    // Alvo já passado: set_target retorna true e não arma
+    if (t_us == UINT64_MAX || !hardware_alarm_set_target((uint)wait_alarm[core],
+                                                         from_us_since_boot(t_us))) {
+        __wfe();
+    }
+}
+
+// O M0+ não tem o DWT->CYCCNT: o SysTick livre (sem interrupção) faz o papel
+void hal_cycles_init(void) {
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;                  // ENABLE | CLKSOURCE (clock da CPU)
+}
+
+uint32_t hal_cycles(void) {
+    return systick_hw->cvr;
+}
+
+uint32_t hal_cycles_elapsed(uint32_t start) {
+    return (start - systick_hw->cvr) & SYSTICK_MASK;
+}
+
+uint32_t hal_cycles_hz(void) {
+    return clock_get_hz(clk_sys);
+}
@@ -0,0 +1,111 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "irrigation_fsm.h"                 // Máquina de estados da irrigação
+
+// Lógica pura: não acessa hardware. Quem chama aplica 'pump_on' na bomba
+// e arma um alarme para 'deadline_us'.
+
+static void enter_state(irrigation_fsm_t *fsm, irrigation_state_t state,
+                        irrigation_reason_t reason, uint64_t now_us, uint32_t timeout_ms) {
+    fsm->state = state;
+    fsm->reason = reason;
+    fsm->entered_us = now_us;
+    fsm->deadline_us = timeout_ms ? now_us + (uint64_t)timeout_ms * 1000u : 0;
+    fsm->pump_on = (state == IRRIGATION_DOSING);
+    fsm->dose_wanted = false;
+    fsm->dose_granted = false;
+}
+
+// Inicia a dose se liberada; senão, pede a vez ao escalonador
+static void request_dose(irrigation_fsm_t *fsm, uint64_t now_us) {
+    if (!fsm->dose_granted) {
+        fsm->dose_wanted = true;
+        return;
+    }
+    fsm->doses++;
+    uint32_t ms = fsm->next_dose_ms;
+    fsm->dose_ms = ms == 0 || ms > fsm->cfg.dose_ms ? fsm->cfg.dose_ms : ms;
+    enter_state(fsm, IRRIGATION_DOSING, IRRIGATION_REASON_DRY, now_us, fsm->dose_ms);
+}
+
+static bool deadline_expired(const irrigation_fsm_t *fsm, uint64_t now_us) {
+    return fsm->deadline_us != 0 && now_us >= fsm->deadline_us;
+}
+
+void irrigation_fsm_init(irrigation_fsm_t *fsm, const irrigation_config_t *cfg) {
+    fsm->cfg = *cfg;
+    fsm->doses = 0;
+    fsm->dose_ms = 0;
+    fsm->next_dose_ms = 0;
+    fsm->soak_done = false;
+    fsm->on_target = false;
+    enter_state(fsm, IRRIGATION_IDLE, IRRIGATION_REASON_NONE, 0, 0);
+}
+
+bool irrigation_fsm_update(irrigation_fsm_t *fsm, uint16_t counts, uint64_t now_us) {
+    const irrigation_config_t *cfg = &fsm->cfg;
+    irrigation_state_t before = fsm->state;
+    bool dry = counts > cfg->dry_counts;
+    bool too_wet = counts < cfg->wet_counts;
+
+    switch (fsm->state) {
+        case IRRIGATION_IDLE:
+            // Solo secou: inicia a primeira dose do ciclo
+            if (dry) {
+                fsm->doses = 0;
+                request_dose(fsm, now_us);
+            } else {
+                fsm->dose_wanted = false;
+            }
+            break;
+
+        case IRRIGATION_DOSING:
+            // A dose tem a duração calculada: a leitura atrasada não a encerra
+            // (desligar no limiar fazia a bomba oscilar em torno dele);
+            // só o solo encharcado corta antes
+            if (too_wet) {
+                enter_state(fsm, IRRIGATION_LOCKOUT, IRRIGATION_REASON_TOO_WET, now_us, cfg->lockout_ms);
+            } else if (deadline_expired(fsm, now_us)) {
+                enter_state(fsm, IRRIGATION_SOAKING, IRRIGATION_REASON_TIMEOUT, now_us, cfg->soak_ms);
+            }
+            break;
+
+        case IRRIGATION_SOAKING:
+            // A umidade responde com atraso: só reavalia com a leitura assentada
+            if (too_wet) {
+                enter_state(fsm, IRRIGATION_LOCKOUT, IRRIGATION_REASON_TOO_WET, now_us, cfg->lockout_ms);
+            } else if (fsm->soak_done || deadline_expired(fsm, now_us)) {
+                irrigation_reason_t reason = fsm->soak_done ? IRRIGATION_REASON_SETTLED
+                                                            : IRRIGATION_REASON_TIMEOUT;
+                if (fsm->on_target) {
+                    fsm->doses = 0;
+                    enter_state(fsm, IRRIGATION_IDLE, reason, now_us, 0);
+                } else if (fsm->doses >= cfg->max_doses) {
+                    // Sensor ou reservatório com problema: evita bombear sem fim
+                    enter_state(fsm, IRRIGATION_LOCKOUT, IRRIGATION_REASON_MAX_DOSES, now_us, cfg->lockout_ms);
+                } else {
+                    request_dose(fsm, now_us);
+                }
+            }
+            break;
+
+        case IRRIGATION_LOCKOUT:
+            // Libera somente depois do prazo e com o solo fora da faixa encharcada
+            if (deadline_expired(fsm, now_us) && !too_wet) {
+                fsm->doses = 0;
+                enter_state(fsm, IRRIGATION_IDLE, IRRIGATION_REASON_TIMEOUT, now_us, 0);
+            }
+            break;
+    }
+
+    return fsm->state != before;
+}
+
+const char *irrigation_state_name(irrigation_state_t state) {
+    switch (state) {
+        case IRRIGATION_IDLE:    return "ocioso";
+        case IRRIGATION_DOSING:  return "irrigando";
+        case IRRIGATION_SOAKING: return "encharcando";
+        case IRRIGATION_LOCKOUT: return "bloqueado";
+    }
+    return "?";
+}
@@ -0,0 +1,65 @@
+#ifndef IRRIGATION_FSM_H
+#define IRRIGATION_FSM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Estados da irrigação
+typedef enum {
+    IRRIGATION_IDLE = 0,     // Solo adequado, bomba desligada
+    IRRIGATION_DOSING,       // Bomba ligada (dose em andamento)
+    IRRIGATION_SOAKING,      // Bomba desligada aguardando a água se espalhar no solo
+    IRRIGATION_LOCKOUT       // Solo encharcado ou doses demais: bomba bloqueada
+} irrigation_state_t;
+
+// Motivo da última transição (para relatório)
+typedef enum {
+    IRRIGATION_REASON_NONE = 0,
+    IRRIGATION_REASON_DRY,           // Leitura acima do limiar de solo seco
+    IRRIGATION_REASON_THRESHOLD,     // Dose encerrada ao cruzar o limiar de umidade
+    IRRIGATION_REASON_TIMEOUT,       // Fim do tempo de dose, encharcamento ou bloqueio
+    IRRIGATION_REASON_TOO_WET,       // Leitura abaixo do limiar de solo encharcado
+    IRRIGATION_REASON_MAX_DOSES,     // Doses consecutivas sem atingir a umidade
+    IRRIGATION_REASON_SETTLED        // Leitura assentou após a dose
+} irrigation_reason_t;
+
+// Parâmetros em contagens do ADC de 16 bits (contagens altas = solo seco)
+typedef struct {
+    uint16_t dry_counts;       // Acima disso o solo está seco e precisa de água
+    uint16_t wet_counts;       // Abaixo disso o solo está encharcado
+    uint32_t dose_ms;          // Duração máxima de uma dose (segurança)
+    uint32_t soak_ms;          // Encharcamento máximo, se a leitura não assentar antes
+    uint32_t lockout_ms;       // Bloqueio mínimo após encharcar
+    uint8_t max_doses;         // Doses consecutivas antes de bloquear
+} irrigation_config_t;
+
+typedef struct {
+    irrigation_config_t cfg;
+    irrigation_state_t state;
+    irrigation_reason_t reason;  // Motivo da última transição
+    uint64_t entered_us;         // Instante de entrada no estado atual
+    uint64_t deadline_us;        // Fim do estado temporizado (0 = sem prazo)
+    uint8_t doses;               // Doses consecutivas no ciclo atual
+    uint32_t dose_ms;            // Duração da dose atual
+    bool pump_on;                // Saída desejada para a bomba
+    bool dose_wanted;            // Precisa de uma dose e aguarda a vez da bomba
+    bool dose_granted;           // Escalonador liberou a dose (consumido ao irrigar)
+    // Entradas do controle de dosagem (dose_control), atualizadas a cada passo
+    uint32_t next_dose_ms;       // Duração da próxima dose (0 = máxima)
+    bool soak_done;              // Encharcando: a leitura assentou
+    bool on_target;              // Leitura no alvo: o ciclo pode terminar
+} irrigation_fsm_t;
+
+void irrigation_fsm_init(irrigation_fsm_t *fsm, const irrigation_config_t *cfg);
+
+// Avança a máquina com uma nova leitura; retorna true se o estado mudou.
+// Prazos vencidos também são tratados aqui (now_us >= deadline_us).
+// Uma dose só começa com 'dose_granted'; sem ela, a máquina fica onde está
+// com 'dose_wanted' até o escalonador das bombas liberar.
+// Ciclo: solo seco → doses de 'next_dose_ms', cada uma seguida de
+// encharcamento até 'soak_done' → ocioso quando 'on_target'.
+bool irrigation_fsm_update(irrigation_fsm_t *fsm, uint16_t counts, uint64_t now_us);
+
+const char *irrigation_state_name(irrigation_state_t state);
+
+#endif // IRRIGATION_FSM_H
@@ -0,0 +1,78 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "low_power.h"                      // Declarações do modo de baixo consumo
+#include "pico/stdlib.h"                    // Temporização (sleep_until)
+#include "pico/stdio_usb.h"                 // Estado da conexão USB
+#include "hardware/clocks.h"                // Registradores sleep_en
+#include "hardware/structs/scb.h"           // Bit SLEEPDEEP do núcleo
+
+// ===== ESTIMATIVA DE ENERGIA =====
+// µA × µs × mV = 1e-15 J: divide por 1e9 para µJ
+static uint64_t charge_uas(const low_power_cycle_t *c) {
+    return (uint64_t)c->awake_us * LOW_POWER_ACTIVE_UA
+         + (uint64_t)c->sleep_us * LOW_POWER_SLEEP_UA
+         + (uint64_t)c->sensor_us * LOW_POWER_SENSOR_UA
+         + (uint64_t)c->display_us * LOW_POWER_DISPLAY_UA;
+}
+
+uint32_t low_power_cycle_energy_uj(const low_power_cycle_t *c) {
+    return (uint32_t)(charge_uas(c) * LOW_POWER_VOLTAGE_MV / 1000000000u);
+}
+
+uint32_t low_power_cycle_avg_ua(const low_power_cycle_t *c) {
+    uint64_t total_us = (uint64_t)c->awake_us + c->sleep_us;
+    return total_us ? (uint32_t)(charge_uas(c) / total_us) : 0;
+}
+
+// ===== INTERVALO ADAPTATIVO =====
+void low_power_interval_init(low_power_interval_t *ai) {
+    ai->interval_ms = LOW_POWER_MIN_INTERVAL_MS;
+    ai->has_last = false;
+}
+
+// Escolhe o intervalo em que a tensão deve variar cerca de LOW_POWER_STEP_MV.
+// Cresce no máximo 2x por medição, para não perder uma secagem que acelera.
+uint32_t low_power_interval_update(low_power_interval_t *ai, float voltage, uint64_t now_us) {
+    if (ai->has_last && now_us > ai->last_us) {
+        float dv_mv = (voltage - ai->last_voltage) * 1000.0f;
+        if (dv_mv < 0) dv_mv = -dv_mv;
+        uint32_t dt_ms = (uint32_t)((now_us - ai->last_us) / 1000u);
+
+        uint32_t target = LOW_POWER_MAX_INTERVAL_MS;
+        if (dv_mv > 0.5f) {
+            float t = (float)dt_ms * LOW_POWER_STEP_MV / dv_mv;
+            if (t < (float)LOW_POWER_MAX_INTERVAL_MS) target = (uint32_t)t;
+        }
+        if (target > ai->interval_ms * 2) target = ai->interval_ms * 2;
+        if (target < LOW_POWER_MIN_INTERVAL_MS) target = LOW_POWER_MIN_INTERVAL_MS;
+        if (target > LOW_POWER_MAX_INTERVAL_MS) target = LOW_POWER_MAX_INTERVAL_MS;
+        ai->interval_ms = target;
+    }
+    ai->last_voltage = voltage;
+    ai->last_us = now_us;
+    ai->has_last = true;
+    return ai->interval_ms;
+}
+
+// ===== SONO =====
+// Durante o sono, mantém apenas o timer (e a USB, se houver host)
+static void set_sleep_clocks(void) {
+    uint32_t en1 = CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS;
+    if (stdio_usb_connected()) {
+        en1 |= CLOCKS_SLEEP_EN1_CLK_SYS_USBCTRL_BITS | CLOCKS_SLEEP_EN1_CLK_USB_USBCTRL_BITS;
+    }
+    clocks_hw->sleep_en0 = 0;
+    clocks_hw->sleep_en1 = en1;
+}
+
+void low_power_sleep_until(absolute_time_t t) {
+    set_sleep_clocks();
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+    sleep_until(t);                          // WFE; o alarme do timer acorda
+    scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+}
+
+void low_power_wait_until(absolute_time_t t) {
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+    best_effort_wfe_or_timeout(t);
+    scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+}
@@ -0,0 +1,64 @@
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/types.h"
+
+// Modo de baixo consumo (bateria/solar). Pode ser definido pelo CMake
+// (-DPICO_PLANT_LOW_POWER=ON)
+#ifndef PICO_PLANT_LOW_POWER
+#define PICO_PLANT_LOW_POWER 0
+#endif
+
+// Janela de medição: sensor ligado só durante estabilização + amostragem
+#define LOW_POWER_SETTLE_MS 20            // Sensor capacitivo estabiliza após ligar
+#define LOW_POWER_WINDOW_READINGS 4       // Leituras decimadas por janela (10 ms cada)
+
+// Intervalo adaptativo entre medições (solo ocioso)
+#define LOW_POWER_MIN_INTERVAL_MS 2000    // Umidade mudando rápido
+#define LOW_POWER_MAX_INTERVAL_MS 60000   // Umidade estável
+#define LOW_POWER_STEP_MV 20              // Variação de tensão desejada entre medições
+
+// Tempo que o OLED fica ligado após uma mudança de estado
+#define LOW_POWER_DISPLAY_ON_MS 10000
+
+// Correntes nominais para a estimativa de energia (µA, a 3.3 V)
+#define LOW_POWER_VOLTAGE_MV 3300
+#define LOW_POWER_ACTIVE_UA 24000         // RP2040 acordado a 125 MHz
+#define LOW_POWER_SLEEP_UA 1300           // Ambos os núcleos em sleep com clocks desligados
+#define LOW_POWER_SENSOR_UA 5000          // Sensor capacitivo + ADC ligados
+#define LOW_POWER_DISPLAY_UA 12000        // SSD1306 ligado (face típica)
+
+// Tempo gasto em cada carga durante um ciclo de medição
+typedef struct {
+    uint32_t awake_us;       // CPU acordada (core0)
+    uint32_t sleep_us;       // Dormindo até a próxima medição
+    uint32_t sensor_us;      // Sensor alimentado
+    uint32_t display_us;     // OLED ligado
+} low_power_cycle_t;
+
+// Estimativa de energia (µJ) e corrente média (µA) de um ciclo
+uint32_t low_power_cycle_energy_uj(const low_power_cycle_t *cycle);
+uint32_t low_power_cycle_avg_ua(const low_power_cycle_t *cycle);
+
+// Intervalo entre medições proporcional à velocidade de secagem
+typedef struct {
+    uint32_t interval_ms;
+    float last_voltage;
+    uint64_t last_us;
+    bool has_last;
+} low_power_interval_t;
+
+void low_power_interval_init(low_power_interval_t *ai);
+uint32_t low_power_interval_update(low_power_interval_t *ai, float voltage, uint64_t now_us);
+
+// Dorme até 't' com o clock dos periféricos desligado (SLEEPDEEP + sleep_en).
+// O timer continua ativo para acordar; a USB só se estiver conectada.
+// O corte de clocks só ocorre quando os dois núcleos estão dormindo.
+void low_power_sleep_until(absolute_time_t t);
+
+// Espera por evento (__sev) ou até 't', também em sleep profundo
+void low_power_wait_until(absolute_time_t t);
+
+#endif // LOW_POWER_H
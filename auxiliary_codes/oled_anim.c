@@ -0,0 +1,91 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "oled_anim.h"                      // Reprodutor de animações
+#include "face_sprites.h"                   // Sprites das faces (flash)
+#include "prof.h"                           // Tempo de cada quadro
+
+#define FRAME_US (OLED_ANIM_FRAME_MS * 1000ull)
+
+// ===== ANIMAÇÕES DAS FACES =====
+
+// Piscar: olhos abertos por ~3 s, fecham e abrem em 200 ms
+static const oled_anim_frame_t happy_blink_frames[] = {
+    {&face_happy,        60},
+    {&face_happy_half,    1},
+    {&face_happy_closed,  2},
+    {&face_happy_half,    1},
+};
+
+// Lágrima escorrendo até a bochecha e recomeçando
+static const oled_anim_frame_t sad_tears_frames[] = {
+    {&face_sad,       8},
+    {&face_sad_tear1, 3},
+    {&face_sad_tear2, 3},
+    {&face_sad_tear3, 3},
+};
+
+const oled_animation_t anim_happy_blink = {
+    happy_blink_frames, sizeof(happy_blink_frames) / sizeof(happy_blink_frames[0]), true
+};
+
+const oled_animation_t anim_sad_tears = {
+    sad_tears_frames, sizeof(sad_tears_frames) / sizeof(sad_tears_frames[0]), true
+};
+
+// ===== REPRODUTOR =====
+
+static void show_frame(oled_anim_player_t *player) {
+    const oled_anim_frame_t *f = &player->anim->frames[player->frame];
+    oled_blit_sprite(f->sprite, player->x, player->page);
+}
+
+void oled_anim_play(oled_anim_player_t *player, const oled_animation_t *anim,
+                    int x, int page, uint64_t now_us) {
+    player->anim = anim;
+    player->x = x;
+    player->page = page;
+    player->frame = 0;
+    player->next_us = now_us + anim->frames[0].ticks * FRAME_US;
+    show_frame(player);
+}
+
+bool oled_anim_tick(oled_anim_player_t *player, uint64_t now_us) {
+    PROF_SCOPE(PROF_ANIM_TICK);
+    const oled_animation_t *anim = player->anim;
+    if (anim == NULL || now_us < player->next_us) {
+        return false;
+    }
+
+    uint8_t next = player->frame + 1;
+    if (next >= anim->frame_count) {
+        if (!anim->loop) {
+            player->anim = NULL;        // Fica no último quadro
+            return false;
+        }
+        next = 0;
+    }
+    player->frame = next;
+
+    // Prazo absoluto: atrasos do laço não se acumulam na cadência
+    player->next_us += anim->frames[next].ticks * FRAME_US;
+    if (player->next_us < now_us) {
+        player->next_us = now_us;
+    }
+    show_frame(player);
+    return true;
+}
+
+// ===== FACES PARADAS =====
+
+// Desenhar rosto feliz (sprite pré-renderizado na flash)
+void draw_happy_face(void) {
+    oled_clear();
+    oled_blit_sprite(&face_happy, FACE_SPRITE_X, 0);
+    oled_update_async();
+}
+
+// Desenhar rosto triste (sprite pré-renderizado na flash)
+void draw_sad_face(void) {
+    oled_clear();
+    oled_blit_sprite(&face_sad, FACE_SPRITE_X, 0);
+    oled_update_async();
+}
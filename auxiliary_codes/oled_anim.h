@@ -0,0 +1,46 @@
+#ifndef OLED_ANIM_H
+#define OLED_ANIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "oled_ssd1306.h"
+
+// Período base das animações: cada quadro dura um múltiplo dele
+#define OLED_ANIM_FRAME_MS 50      // 20 quadros por segundo
+
+typedef struct {
+    const oled_sprite_t *sprite;
+    uint8_t ticks;                  // Duração em períodos de OLED_ANIM_FRAME_MS
+} oled_anim_frame_t;
+
+typedef struct {
+    const oled_anim_frame_t *frames;
+    uint8_t frame_count;
+    bool loop;
+} oled_animation_t;
+
+// Reprodutor: copia o quadro atual para o back buffer na hora certa
+typedef struct {
+    const oled_animation_t *anim;
+    int x;                          // Coluna de destino
+    int page;                       // Página de destino
+    uint8_t frame;
+    uint64_t next_us;               // Prazo absoluto da próxima troca de quadro
+} oled_anim_player_t;
+
+// Inicia a animação e desenha o primeiro quadro
+void oled_anim_play(oled_anim_player_t *player, const oled_animation_t *anim,
+                    int x, int page, uint64_t now_us);
+
+// Troca de quadro se o prazo venceu; true = back buffer alterado
+bool oled_anim_tick(oled_anim_player_t *player, uint64_t now_us);
+
+// Animações das faces
+extern const oled_animation_t anim_happy_blink;
+extern const oled_animation_t anim_sad_tears;
+
+// Faces paradas, tela inteira (sprites gerados em tempo de build)
+void draw_happy_face(void);
+void draw_sad_face(void);
+
+#endif // OLED_ANIM_H
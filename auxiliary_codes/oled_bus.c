@@ -0,0 +1,73 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "oled_bus.h"                       // Interface do transporte do display
+#include "oled_ssd1306.h"                   // Porta e endereço I2C
+#include "hardware/i2c.h"                   // Registradores do bloco I2C
+#include "hardware/dma.h"                   // DMA do front buffer para o FIFO
+#include "hardware/gpio.h"                  // Função dos pinos SDA/SCL
+
+static int dma_chan = -1;
+
+// Configura o barramento do display; retorna a frequência obtida
+uint32_t oled_bus_init(uint32_t sda, uint32_t scl, uint32_t baudrate) {
+    uint32_t actual = i2c_init(I2C_PORT, baudrate);
+    gpio_set_function(sda, GPIO_FUNC_I2C);
+    gpio_set_function(scl, GPIO_FUNC_I2C);
+    gpio_pull_up(sda);                 // Pull-ups necessários para I2C
+    gpio_pull_up(scl);
+
+    // Um canal para os dados: palavras de 16 bits do front buffer para IC_DATA_CMD
+    if (dma_chan < 0) {
+        dma_chan = dma_claim_unused_channel(true);
+        dma_channel_config c = dma_channel_get_default_config(dma_chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, i2c_get_dreq(I2C_PORT, true));
+        dma_channel_configure(dma_chan, &c, &i2c_get_hw(I2C_PORT)->data_cmd, NULL, 0, false);
+    }
+    return actual;
+}
+
+bool oled_bus_write(const uint8_t *buf, size_t len) {
+    return i2c_write_blocking(I2C_PORT, I2C_ADDR, buf, len, false) == (int)len;
+}
+
+void oled_bus_begin(void) {
+    // Endereço do escravo só pode mudar com o bloco I2C desabilitado
+    i2c_hw_t *hw = i2c_get_hw(I2C_PORT);
+    hw->enable = 0;
+    hw->tar = I2C_ADDR;
+    hw->enable = 1;
+}
+
+size_t oled_bus_space(void) {
+    return i2c_get_write_available(I2C_PORT);
+}
+
+void oled_bus_put(uint16_t word) {
+    i2c_get_hw(I2C_PORT)->data_cmd = word;
+}
+
+void oled_bus_put_dma(const uint16_t *words, size_t count) {
+    dma_channel_transfer_from_buffer_now(dma_chan, words, count);
+}
+
+bool oled_bus_dma_busy(void) {
+    return dma_channel_is_busy(dma_chan);
+}
+
+bool oled_bus_idle(void) {
+    // Último byte saiu do FIFO e o mestre liberou o barramento
+    i2c_hw_t *hw = i2c_get_hw(I2C_PORT);
+    return (hw->status & I2C_IC_STATUS_TFE_BITS) && !(hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+}
+
+bool oled_bus_take_abort(void) {
+    i2c_hw_t *hw = i2c_get_hw(I2C_PORT);
+    if (!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+        return false;
+    }
+    dma_channel_abort(dma_chan);
+    (void)hw->clr_tx_abrt;
+    return true;
+}
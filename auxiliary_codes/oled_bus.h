@@ -0,0 +1,31 @@
+#ifndef OLED_BUS_H
+#define OLED_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Transporte do SSD1306: I2C + DMA no Pico (oled_bus.c) ou painel virtual
+// no simulador (host/oled_bus_sim.c). O desenho e o planejamento das
+// janelas ficam em oled_ssd1306.c e não dependem do hardware.
+
+// Palavras do envio assíncrono: byte nos bits 0..7; OLED_BUS_STOP encerra
+// a transação. Mesmo formato do registrador IC_DATA_CMD do RP2040, para o
+// DMA escrever as palavras direto no FIFO.
+#define OLED_BUS_STOP 0x200
+
+uint32_t oled_bus_init(uint32_t sda, uint32_t scl, uint32_t baudrate);
+
+// Uma transação completa (bloqueante); false = sem ACK
+bool oled_bus_write(const uint8_t *buf, size_t len);
+
+// Envio assíncrono, alimentado por oled_update_poll()
+void oled_bus_begin(void);                      // Endereça o painel antes de um quadro
+size_t oled_bus_space(void);                    // Palavras que cabem no FIFO agora
+void oled_bus_put(uint16_t word);               // Uma palavra pela CPU
+void oled_bus_put_dma(const uint16_t *words, size_t count);  // Bloco pelo DMA
+bool oled_bus_dma_busy(void);
+bool oled_bus_idle(void);                       // FIFO vazio e barramento liberado
+bool oled_bus_take_abort(void);                 // Sem ACK: cancela o DMA e limpa o aborto
+
+#endif // OLED_BUS_H
@@ -0,0 +1,11 @@
+#ifndef OLED_FONT_H
+#define OLED_FONT_H
+
+#include "oled_ssd1306.h"
+
+// Fontes de largura fixa para oled_draw_text (dados const, ficam na flash)
+
+extern const oled_font_t oled_font_5x7;         // ASCII imprimível, 6 colunas por caractere
+extern const oled_font_t oled_font_digits_7x16; // Dígitos grandes, '-' e '.'; 8 colunas
+
+#endif // OLED_FONT_H
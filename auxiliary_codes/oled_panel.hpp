@@ -0,0 +1,325 @@
+#ifndef OLED_PANEL_HPP
+#define OLED_PANEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "oled_ssd1306.h"           // oled_sprite_t e oled_font_t (mesmo formato de bytes)
+#include "hal.h"                    // hal_time_us/hal_sleep_us na inicialização
+}
+
+// Driver de painel especializado em tempo de compilação, para displays
+// além do principal (que continua no driver C com DMA, oled_ssd1306.c).
+// Geometria, controlador, barramento e endereço são parâmetros do template:
+// a sequência de inicialização e o tamanho do buffer saem em constexpr, o
+// buffer de cada painel tem exatamente largura × páginas bytes, e não há
+// ponteiro de função nem virtual — cada painel é um tipo próprio.
+//
+// Barramento: um tipo com 'static bool write(uint8_t addr, const uint8_t *buf,
+// size_t len)' (uma transação; false = sem ACK). Ver oled_panel_pico.hpp.
+
+namespace oled {
+
+enum class Controller : uint8_t {
+    SSD1306,                // 128 colunas, endereçamento horizontal com janela
+    SH1106,                 // 132 colunas (painel centralizado), só por página
+};
+
+template <unsigned Width, unsigned Height>
+struct Geometry {
+    static_assert(Width >= 8 && Width <= 128, "largura do painel: 8..128 colunas");
+    static_assert(Height % 8 == 0 && Height >= 16 && Height <= 64,
+                  "altura do painel: páginas inteiras, 16..64 linhas");
+    static constexpr int width = Width;
+    static constexpr int height = Height;
+    static constexpr int pages = Height / 8;
+    static constexpr std::size_t buffer_size = std::size_t(Width) * pages;
+};
+
+using Geometry128x64 = Geometry<128, 64>;
+using Geometry128x32 = Geometry<128, 32>;
+using Geometry64x48 = Geometry<64, 48>;
+using Geometry72x40 = Geometry<72, 40>;
+
+// ===== PARÂMETROS DO CONTROLADOR =====
+template <class G, Controller C>
+struct Traits {
+    // Colunas da RAM do controlador; painéis menores ficam no meio
+    static constexpr int ram_columns = C == Controller::SH1106 ? 132 : 128;
+    static constexpr int column_offset = (ram_columns - G::width) / 2;
+    // Pinos COM: sequenciais nos painéis de 16 e 32 linhas, alternados nos demais
+    static constexpr uint8_t com_pins = G::height <= 32 && C == Controller::SSD1306 ? 0x02 : 0x12;
+};
+
+// Comandos comuns aos dois controladores
+constexpr uint8_t CMD_DISPLAY_OFF = 0xAE;
+constexpr uint8_t CMD_DISPLAY_ON = 0xAF;
+constexpr uint8_t CMD_CLOCK_DIV = 0xD5;
+constexpr uint8_t CMD_MULTIPLEX = 0xA8;
+constexpr uint8_t CMD_DISPLAY_OFFSET = 0xD3;
+constexpr uint8_t CMD_START_LINE = 0x40;
+constexpr uint8_t CMD_SEG_REMAP = 0xA1;
+constexpr uint8_t CMD_COM_SCAN_DEC = 0xC8;
+constexpr uint8_t CMD_COM_PINS = 0xDA;
+constexpr uint8_t CMD_CONTRAST = 0x81;
+constexpr uint8_t CMD_PRECHARGE = 0xD9;
+constexpr uint8_t CMD_VCOM_DETECT = 0xDB;
+constexpr uint8_t CMD_RESUME = 0xA4;
+constexpr uint8_t CMD_NORMAL = 0xA6;
+// SSD1306
+constexpr uint8_t CMD_CHARGE_PUMP = 0x8D;
+constexpr uint8_t CMD_MEMORY_MODE = 0x20;
+constexpr uint8_t CMD_COLUMN_ADDR = 0x21;
+constexpr uint8_t CMD_PAGE_ADDR = 0x22;
+// SH1106
+constexpr uint8_t CMD_DCDC = 0xAD;
+constexpr uint8_t CMD_PUMP_VOLTAGE = 0x30;
+constexpr uint8_t CMD_PAGE_START = 0xB0;
+constexpr uint8_t CMD_COLUMN_LOW = 0x00;
+constexpr uint8_t CMD_COLUMN_HIGH = 0x10;
+
+// Sequência de inicialização inteira em uma transação, calculada na compilação
+template <class G, Controller C>
+constexpr auto init_sequence() {
+    constexpr uint8_t mux = uint8_t(G::height - 1);
+    constexpr uint8_t com = Traits<G, C>::com_pins;
+    if constexpr (C == Controller::SSD1306) {
+        return std::array<uint8_t, 25>{
+            CMD_DISPLAY_OFF,
+            CMD_CLOCK_DIV, 0x80,
+            CMD_MULTIPLEX, mux,
+            CMD_DISPLAY_OFFSET, 0x00,
+            CMD_START_LINE,
+            CMD_CHARGE_PUMP, 0x14,
+            CMD_MEMORY_MODE, 0x00,              // Horizontal: janelas com avanço automático
+            CMD_SEG_REMAP,
+            CMD_COM_SCAN_DEC,
+            CMD_COM_PINS, com,
+            CMD_CONTRAST, 0xCF,
+            CMD_PRECHARGE, 0xF1,
+            CMD_VCOM_DETECT, 0x40,
+            CMD_RESUME,
+            CMD_NORMAL,
+            CMD_DISPLAY_ON,
+        };
+    } else {
+        return std::array<uint8_t, 24>{
+            CMD_DISPLAY_OFF,
+            CMD_CLOCK_DIV, 0x80,
+            CMD_MULTIPLEX, mux,
+            CMD_DISPLAY_OFFSET, 0x00,
+            CMD_START_LINE,
+            CMD_DCDC, 0x8B,                     // Conversor interno ligado
+            uint8_t(CMD_PUMP_VOLTAGE | 0x02),   // 8.0 V
+            CMD_SEG_REMAP,
+            CMD_COM_SCAN_DEC,
+            CMD_COM_PINS, com,
+            CMD_CONTRAST, 0x80,
+            CMD_PRECHARGE, 0x22,
+            CMD_VCOM_DETECT, 0x35,
+            CMD_RESUME,
+            CMD_NORMAL,
+            CMD_DISPLAY_ON,
+        };
+    }
+}
+
+// ===== PAINEL =====
+template <class G, Controller C, class Bus, uint8_t Address>
+class Panel {
+public:
+    using geometry = G;
+    static constexpr auto init_cmds = init_sequence<G, C>();
+    static constexpr int power_up_timeout_ms = 100;
+    static constexpr std::size_t chunk = 32;    // Bytes por transação (buffer na pilha)
+
+    Panel() { mark_all_dirty(); }
+
+    // Repete a sequência até o controlador responder; false = sem resposta
+    bool init() {
+        uint64_t deadline = hal_time_us() + power_up_timeout_ms * 1000ull;
+        bool ack;
+        while (!(ack = send_cmds(init_cmds.data(), init_cmds.size())) && hal_time_us() < deadline) {
+            hal_sleep_us(500);
+        }
+        mark_all_dirty();                       // RAM do painel indefinida após ligar
+        return ack;
+    }
+
+    uint8_t *buffer() { return buf_.data(); }
+
+    void mark_all_dirty() {
+        for (int p = 0; p < G::pages; p++) {
+            dirty_min_[p] = 0;
+            dirty_max_[p] = G::width - 1;
+        }
+    }
+
+    void clear() {
+        buf_.fill(0);
+        mark_all_dirty();
+    }
+
+    void set_pixel(int x, int y, bool on) {
+        if (x < 0 || x >= G::width || y < 0 || y >= G::height) return;
+        uint8_t *b = &buf_[(y >> 3) * G::width + x];
+        uint8_t mask = uint8_t(1u << (y & 7));
+        *b = on ? uint8_t(*b | mask) : uint8_t(*b & ~mask);
+        mark_dirty(y >> 3, x, x);
+    }
+
+    // Retângulo: uma máscara por página, como oled_fill_rect
+    void fill_rect(int x, int y, int w, int h, bool on) {
+        int x0 = x < 0 ? 0 : x;
+        int y0 = y < 0 ? 0 : y;
+        int x1 = x + w - 1 < G::width ? x + w - 1 : G::width - 1;
+        int y1 = y + h - 1 < G::height ? y + h - 1 : G::height - 1;
+        if (x0 > x1 || y0 > y1) return;
+        for (int p = y0 >> 3; p <= (y1 >> 3); p++) {
+            int r0 = p == (y0 >> 3) ? (y0 & 7) : 0;
+            int r1 = p == (y1 >> 3) ? (y1 & 7) : 7;
+            uint8_t mask = uint8_t((0xFF << r0) & (0xFF >> (7 - r1)));
+            uint8_t *b = &buf_[p * G::width];
+            for (int i = x0; i <= x1; i++) {
+                b[i] = on ? uint8_t(b[i] | mask) : uint8_t(b[i] & ~mask);
+            }
+            mark_dirty(p, x0, x1);
+        }
+    }
+
+    // Sprite página a página (mesmo formato do driver principal)
+    void blit(const oled_sprite_t &sprite, int x, int page) {
+        int src_x = x < 0 ? -x : 0;
+        int x0 = x < 0 ? 0 : x;
+        int w = sprite.width - src_x;
+        if (x0 + w > G::width) w = G::width - x0;
+        if (w <= 0) return;
+        for (int p = 0; p < sprite.pages; p++) {
+            int dst = page + p;
+            if (dst < 0 || dst >= G::pages) continue;
+            std::memcpy(&buf_[dst * G::width + x0], &sprite.data[p * sprite.width + src_x], w);
+            mark_dirty(dst, x0, x0 + w - 1);
+        }
+    }
+
+    // Glifo opaco, copiado por linha de página (deslocado fora do alinhamento)
+    int draw_char(const oled_font_t &font, int x, int y, char c, bool on) {
+        int adv = font.width + font.spacing;
+        int x0 = x < 0 ? 0 : x;
+        int x1 = x + adv - 1 < G::width ? x + adv - 1 : G::width - 1;
+        if (x0 > x1 || y >= G::height || y + font.pages * 8 <= 0) return x + adv;
+        const uint8_t *glyph = c >= font.first && c <= font.last
+                                   ? &font.data[(c - font.first) * font.width * font.pages]
+                                   : nullptr;
+        uint8_t inv = on ? 0x00 : 0xFF;
+        int shift = y & 7;
+        int page = y >> 3;
+        for (int p = 0; p < font.pages; p++, page++) {
+            for (int i = x0; i <= x1; i++) {
+                int gx = i - x;
+                uint8_t b = uint8_t((glyph && gx < font.width ? glyph[p * font.width + gx] : 0) ^ inv);
+                put(page, i, uint8_t(b << shift), uint8_t(0xFF << shift));
+                if (shift) {
+                    put(page + 1, i, uint8_t(b >> (8 - shift)), uint8_t(0xFF >> (8 - shift)));
+                }
+            }
+            mark_dirty_clipped(page, x0, x1);
+            if (shift) mark_dirty_clipped(page + 1, x0, x1);
+        }
+        return x + adv;
+    }
+
+    int draw_text(const oled_font_t &font, int x, int y, const char *text, bool on) {
+        while (*text && x < G::width) {
+            x = draw_char(font, x, y, *text++, on);
+        }
+        return x;
+    }
+
+    // Envia as colunas alteradas de cada página (bloqueante); false = sem ACK,
+    // e o quadro inteiro fica para a próxima vez
+    bool update() {
+        bool ack = true;
+        for (int p = 0; p < G::pages; p++) {
+            if (dirty_min_[p] > dirty_max_[p]) continue;
+            int x0 = dirty_min_[p];
+            int x1 = dirty_max_[p];
+            ack &= set_window(p, x0, x1);
+            ack &= send_data(&buf_[p * G::width + x0], std::size_t(x1 - x0 + 1));
+            dirty_min_[p] = G::width;
+            dirty_max_[p] = -1;
+        }
+        if (!ack) mark_all_dirty();
+        return ack;
+    }
+
+    bool set_display_on(bool on) {
+        uint8_t cmd = on ? CMD_DISPLAY_ON : CMD_DISPLAY_OFF;
+        return send_cmds(&cmd, 1);
+    }
+
+private:
+    std::array<uint8_t, G::buffer_size> buf_{};
+    std::array<int16_t, G::pages> dirty_min_{};
+    std::array<int16_t, G::pages> dirty_max_{};
+
+    void mark_dirty(int page, int x0, int x1) {
+        if (x0 < dirty_min_[page]) dirty_min_[page] = int16_t(x0);
+        if (x1 > dirty_max_[page]) dirty_max_[page] = int16_t(x1);
+    }
+
+    void mark_dirty_clipped(int page, int x0, int x1) {
+        if (page >= 0 && page < G::pages) mark_dirty(page, x0, x1);
+    }
+
+    void put(int page, int x, uint8_t bits, uint8_t mask) {
+        if (page < 0 || page >= G::pages) return;
+        uint8_t *b = &buf_[page * G::width + x];
+        *b = uint8_t((*b & ~mask) | (bits & mask));
+    }
+
+    // Ponteiro de escrita no início da faixa de colunas da página
+    bool set_window(int page, int x0, int x1) {
+        constexpr int off = Traits<G, C>::column_offset;
+        if constexpr (C == Controller::SSD1306) {
+            const uint8_t cmds[] = {
+                CMD_COLUMN_ADDR, uint8_t(x0 + off), uint8_t(x1 + off),
+                CMD_PAGE_ADDR, uint8_t(page), uint8_t(page),
+            };
+            return send_cmds(cmds, sizeof(cmds));
+        } else {
+            (void)x1;                           // Modo página: a coluna avança sozinha
+            const uint8_t cmds[] = {
+                uint8_t(CMD_PAGE_START | page),
+                uint8_t(CMD_COLUMN_LOW | ((x0 + off) & 0x0F)),
+                uint8_t(CMD_COLUMN_HIGH | ((x0 + off) >> 4)),
+            };
+            return send_cmds(cmds, sizeof(cmds));
+        }
+    }
+
+    // Byte de controle 0x00 (comandos) ou 0x40 (dados) e até 'chunk' bytes
+    static bool send(uint8_t control, const uint8_t *bytes, std::size_t len) {
+        uint8_t buf[chunk + 1];
+        buf[0] = control;
+        bool ack = true;
+        while (len > 0) {
+            std::size_t n = len < chunk ? len : chunk;
+            std::memcpy(buf + 1, bytes, n);
+            ack &= Bus::write(Address, buf, n + 1);
+            bytes += n;
+            len -= n;
+        }
+        return ack;
+    }
+
+    static bool send_cmds(const uint8_t *cmds, std::size_t len) { return send(0x00, cmds, len); }
+    static bool send_data(const uint8_t *data, std::size_t len) { return send(0x40, data, len); }
+};
+
+} // namespace oled
+
+#endif // OLED_PANEL_HPP
@@ -0,0 +1,40 @@
+#ifndef OLED_PANEL_PICO_HPP
+#define OLED_PANEL_PICO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "hardware/i2c.h"
+#include "hardware/gpio.h"
+
+// Barramento I2C do RP2040 para oled::Panel (transações bloqueantes). Os
+// pinos são conferidos na compilação: no RP2040 o SDA do I2Cn fica nos
+// GPIOs 4k + 2n e o SCL nos 4k + 2n + 1.
+
+namespace oled {
+
+template <unsigned Index, unsigned Sda, unsigned Scl>
+struct PicoI2c {
+    static_assert(Index <= 1, "RP2040: i2c0 ou i2c1");
+    static_assert(Sda < 30 && Sda % 4 == Index * 2, "SDA fora dos pinos deste I2C");
+    static_assert(Scl < 30 && Scl % 4 == Index * 2 + 1, "SCL fora dos pinos deste I2C");
+
+    static i2c_inst_t *instance() { return Index ? i2c1 : i2c0; }
+
+    // Retorna a frequência obtida
+    static uint32_t init(uint32_t baudrate) {
+        uint32_t hz = i2c_init(instance(), baudrate);
+        gpio_set_function(Sda, GPIO_FUNC_I2C);
+        gpio_set_function(Scl, GPIO_FUNC_I2C);
+        gpio_pull_up(Sda);
+        gpio_pull_up(Scl);
+        return hz;
+    }
+
+    static bool write(uint8_t addr, const uint8_t *buf, std::size_t len) {
+        return i2c_write_blocking(instance(), addr, buf, len, false) == (int)len;
+    }
+};
+
+} // namespace oled
+
+#endif // OLED_PANEL_PICO_HPP
@@ -0,0 +1,175 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "oled_readout.h"                   // Leitura em texto
+#include "oled_font.h"                      // Glifos copiados para o buffer
+#include "text_fmt.h"                       // Números sem printf
+#include "prof.h"                           // Tempo de desenho da leitura
+#include <string.h>
+
+#define READOUT_MAX_ZONES 16
+#define FIELD_MAX_LEN 5                     // 5 caracteres de 6 colunas cabem em 32
+#define FIELD_TEXT_SIZE 12                  // Buffer de text_fmt
+
+// ===== CAMPOS =====
+typedef enum {
+    FIELD_PERCENT = 0,
+    FIELD_VOLTS,
+    FIELD_SINCE,
+    FIELD_ZONE,
+    FIELD_COUNT
+} field_id_t;
+
+typedef struct {
+    const oled_font_t *font;
+    uint8_t x;
+    uint8_t y;                  // Linha do topo (páginas inteiras: cópia direta)
+    uint8_t len;
+} field_t;
+
+static const field_t fields[FIELD_COUNT] = {
+    [FIELD_PERCENT] = {&oled_font_digits_7x16, OLED_READOUT_X, 0, 3},  // Páginas 0-1, "%" ao lado
+    [FIELD_VOLTS] = {&oled_font_5x7, OLED_READOUT_X, 24, 5},           // "1.23V"
+    [FIELD_SINCE] = {&oled_font_5x7, OLED_READOUT_X, 48, 5},           // Abaixo de "rega"
+    [FIELD_ZONE] = {&oled_font_5x7, OLED_READOUT_X, 56, 5},            // "z3" (só com várias zonas)
+};
+
+#define PERCENT_SIGN_X (OLED_READOUT_X + 25)
+#define PERCENT_SIGN_Y 8
+#define LABEL_SINCE_Y 40
+
+// ===== ESTADO =====
+typedef struct {
+    uint16_t water_cml;
+    uint16_t full_cml;
+    uint16_t sensor_mv;
+    bool has_reading;
+    bool pump_on;
+    uint64_t last_pump_us;      // Última leitura com a bomba ligada (0 = nunca)
+} readout_zone_t;
+
+static readout_zone_t zones[READOUT_MAX_ZONES];
+static uint32_t zone_count;
+static uint32_t shown_zone;
+static uint64_t next_zone_us;
+static uint64_t next_draw_us;
+static char shown[FIELD_COUNT][FIELD_MAX_LEN + 1];  // O que está no back buffer
+static bool all_dirty;
+
+void oled_readout_init(uint32_t count) {
+    zone_count = count > READOUT_MAX_ZONES ? READOUT_MAX_ZONES : count;
+    for (uint32_t i = 0; i < zone_count; i++) {
+        zones[i] = (readout_zone_t){0};
+    }
+    shown_zone = 0;
+    next_zone_us = 0;
+    next_draw_us = 0;
+    all_dirty = true;
+}
+
+void oled_readout_set(uint32_t zone, uint16_t water_cml, uint16_t full_cml, uint32_t sensor_mv,
+                      bool pump_on, uint64_t now_us) {
+    if (zone >= zone_count) {
+        return;
+    }
+    readout_zone_t *z = &zones[zone];
+    z->water_cml = water_cml;
+    z->full_cml = full_cml;
+    z->sensor_mv = (uint16_t)sensor_mv;
+    z->has_reading = true;
+    z->pump_on = pump_on;
+    if (pump_on) {
+        z->last_pump_us = now_us ? now_us : 1;
+    }
+}
+
+// ===== TEXTO DE CADA CAMPO =====
+static void format_fields(const readout_zone_t *z, uint64_t now_us,
+                          char text[FIELD_COUNT][FIELD_TEXT_SIZE]) {
+    char *s;
+    uint32_t n;
+
+    s = text[FIELD_PERCENT];
+    if (z->has_reading && z->full_cml) {
+        uint32_t pct = (uint32_t)z->water_cml * 100u / z->full_cml;
+        text_fmt_u32_pad(s, pct > 100 ? 100 : pct, 3, ' ');
+    } else {
+        memcpy(s, " --", 4);
+    }
+
+    s = text[FIELD_VOLTS];
+    if (z->has_reading) {
+        n = text_fmt_fixed(s, z->sensor_mv / 10u, 2);
+        s[n++] = 'V';
+        s[n] = '\0';
+    } else {
+        s[0] = '\0';
+    }
+
+    s = text[FIELD_SINCE];
+    if (z->pump_on) {
+        memcpy(s, "agora", 6);
+    } else if (z->last_pump_us && now_us > z->last_pump_us) {
+        text_fmt_duration(s, (uint32_t)((now_us - z->last_pump_us) / 1000000u));
+    } else {
+        memcpy(s, "--", 3);
+    }
+
+    s = text[FIELD_ZONE];
+    if (zone_count > 1) {
+        s[0] = 'z';
+        text_fmt_u32(&s[1], shown_zone);
+    } else {
+        s[0] = '\0';
+    }
+}
+
+// Redesenha só as posições do campo cujo caractere mudou (espaços completam)
+static bool draw_field(field_id_t id, const char *text) {
+    const field_t *f = &fields[id];
+    char *old = shown[id];
+    bool changed = false;
+    bool ended = false;
+    int adv = oled_text_advance(f->font);
+    for (uint32_t i = 0; i < f->len; i++) {
+        if (!ended && text[i] == '\0') {
+            ended = true;
+        }
+        char c = ended ? ' ' : text[i];
+        if (!all_dirty && old[i] == c) {
+            continue;
+        }
+        oled_draw_char(f->font, f->x + (int)i * adv, f->y, c, true);
+        old[i] = c;
+        changed = true;
+    }
+    return changed;
+}
+
+bool oled_readout_draw(uint64_t now_us) {
+    if (zone_count == 0 || (!all_dirty && now_us < next_draw_us)) {
+        return false;
+    }
+    PROF_SCOPE(PROF_READOUT_DRAW);
+    next_draw_us = now_us + OLED_READOUT_PERIOD_MS * 1000ull;
+    if (zone_count > 1 && now_us >= next_zone_us) {
+        if (next_zone_us) {
+            shown_zone = (shown_zone + 1) % zone_count;
+        }
+        next_zone_us = now_us + OLED_READOUT_ZONE_MS * 1000ull;
+    }
+
+    bool changed = false;
+    if (all_dirty) {
+        // Rótulos fixos: só no primeiro desenho
+        oled_fill_rect(OLED_READOUT_X, 0, OLED_READOUT_WIDTH, OLED_HEIGHT, false);
+        oled_draw_char(&oled_font_5x7, PERCENT_SIGN_X, PERCENT_SIGN_Y, '%', true);
+        oled_draw_text(&oled_font_5x7, OLED_READOUT_X, LABEL_SINCE_Y, "rega", true);
+        changed = true;
+    }
+    char text[FIELD_COUNT][FIELD_TEXT_SIZE];
+    format_fields(&zones[shown_zone], now_us, text);
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        changed |= draw_field((field_id_t)i, text[i]);
+    }
+    all_dirty = false;
+    return changed;
+}
@@ -0,0 +1,28 @@
+#ifndef OLED_READOUT_H
+#define OLED_READOUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "oled_ssd1306.h"
+
+// Leitura em texto à esquerda da face (colunas 0..31): umidade em % com
+// dígitos grandes, tensão do sensor e tempo desde a última rega. Com várias
+// zonas, alterna a zona mostrada. Cada campo guarda o texto que está no
+// back buffer e só os caracteres que mudaram são redesenhados.
+
+#define OLED_READOUT_X 0
+#define OLED_READOUT_WIDTH 32           // Até a face (FACE_SPRITE_X)
+#define OLED_READOUT_PERIOD_MS 100      // Texto refeito no máximo 10 vezes por segundo
+#define OLED_READOUT_ZONE_MS 3000       // Tempo de cada zona na tela
+
+void oled_readout_init(uint32_t zone_count);
+
+// Nova leitura de uma zona (desenha só em oled_readout_draw). Água em
+// centésimos de mL; 'full_cml' = 100%; 'pump_on' marca a última rega.
+void oled_readout_set(uint32_t zone, uint16_t water_cml, uint16_t full_cml, uint32_t sensor_mv,
+                      bool pump_on, uint64_t now_us);
+
+// Redesenha os caracteres que mudaram; true = back buffer alterado
+bool oled_readout_draw(uint64_t now_us);
+
+#endif // OLED_READOUT_H
@@ -1,80 +1,484 @@
 #include "oled_ssd1306.h"
-#include "hardware/i2c.h"
+#include "oled_bus.h"
+#include "hal.h"
+#include "prof.h"                 // Tempo de cada primitiva
 #include <string.h> 
 #include <stdlib.h>   
-#include <math.h>
 
 
-// Buffer do display
+// Buffer do display (back buffer: todo desenho acontece aqui)
 static uint8_t oled_buffer[OLED_WIDTH * OLED_PAGES];
 
+// Front buffer: palavras prontas para o registrador IC_DATA_CMD, lidas pelo DMA.
+// Escritas de 8 bits em registradores do RP2040 são replicadas nos 32 bits
+// (o que ligaria os bits CMD/STOP), por isso cada byte vira uma palavra de 16 bits
+// (formato de oled_bus.h).
+static uint16_t oled_front[OLED_WIDTH * OLED_PAGES];
+static bool front_valid;     // Front buffer igual à RAM do painel
+
+// Região alterada de cada página (colunas); dirty_min > dirty_max = página limpa
+static int16_t dirty_min[OLED_PAGES];
+static int16_t dirty_max[OLED_PAGES];
+
+// Bytes enviados no barramento (inclui o byte de endereço de cada transação)
+static uint32_t bus_bytes;
+static uint32_t last_update_bytes;
+static uint32_t total_update_bytes;
+
+// Marca colunas [x0, x1] da página como alteradas
+static inline void mark_dirty(int page, int x0, int x1) {
+    if (x0 < dirty_min[page]) dirty_min[page] = x0;
+    if (x1 > dirty_max[page]) dirty_max[page] = x1;
+}
+
+static void clear_dirty(void) {
+    for (int p = 0; p < OLED_PAGES; p++) {
+        dirty_min[p] = OLED_WIDTH;
+        dirty_max[p] = -1;
+    }
+}
+
+// Sequência de inicialização enviada em uma única transação
+static const uint8_t oled_init_cmds[] = {
+    SSD1306_DISPLAY_OFF,
+    SSD1306_SET_DISPLAY_CLOCK_DIV, 0x80,
+    SSD1306_SET_MULTIPLEX, OLED_HEIGHT - 1,
+    SSD1306_SET_DISPLAY_OFFSET, 0x00,
+    SSD1306_SET_START_LINE | 0x00,
+    SSD1306_CHARGE_PUMP, 0x14,
+    SSD1306_MEMORY_MODE, 0x00,
+    SSD1306_SEG_REMAP | 0x01,
+    SSD1306_COM_SCAN_DEC,
+    SSD1306_SET_COM_PINS, 0x12,
+    SSD1306_SET_CONTRAST, 0xCF,
+    SSD1306_SET_PRECHARGE, 0xF1,
+    SSD1306_SET_VCOM_DETECT, 0x40,
+    SSD1306_DISPLAY_ALL_ON_RESUME,
+    SSD1306_NORMAL_DISPLAY,
+    SSD1306_DISPLAY_ON,
+};
+
+// Configura o barramento do display; retorna a frequência obtida
+uint32_t oled_i2c_init(uint32_t sda, uint32_t scl, uint32_t baudrate) {
+    return oled_bus_init(sda, scl, baudrate);
+}
+
 // Função para enviar comando
 void oled_send_cmd(uint8_t cmd) {
-    uint8_t buf[2] = {0x00, cmd};
-    i2c_write_blocking(I2C_PORT, I2C_ADDR, buf, 2, false);
+    oled_send_cmd_list(&cmd, 1);
+}
+
+// Envia vários comandos em uma transação (byte de controle 0x00 com Co = 0).
+// Listas maiores que OLED_CMD_CHUNK seguem em transações consecutivas.
+bool oled_send_cmd_list(const uint8_t *cmds, size_t len) {
+    uint8_t buf[OLED_CMD_CHUNK + 1];
+    buf[0] = 0x00;  // Command mode
+    bool ack = true;
+    while (len > 0) {
+        size_t n = len < OLED_CMD_CHUNK ? len : OLED_CMD_CHUNK;
+        memcpy(buf + 1, cmds, n);
+        ack &= oled_bus_write(buf, n + 1);
+        bus_bytes += n + 2;
+        cmds += n;
+        len -= n;
+    }
+    return ack;
 }
 
-// Função para enviar dados
+// Função para enviar dados (bloqueante, em blocos pequenos na pilha).
+// O ponteiro de coluna/página do painel avança entre transações.
 void oled_send_data(uint8_t *data, size_t len) {
-    uint8_t buf[len + 1];
+    uint8_t buf[OLED_DATA_CHUNK + 1];
     buf[0] = 0x40;  // Data mode
-    memcpy(buf + 1, data, len);
-    i2c_write_blocking(I2C_PORT, I2C_ADDR, buf, len + 1, false);
-}
-
-// Inicializar o display
-void oled_init() {
-    oled_send_cmd(SSD1306_DISPLAY_OFF);
-    oled_send_cmd(SSD1306_SET_DISPLAY_CLOCK_DIV);
-    oled_send_cmd(0x80);
-    oled_send_cmd(SSD1306_SET_MULTIPLEX);
-    oled_send_cmd(OLED_HEIGHT - 1);
-    oled_send_cmd(SSD1306_SET_DISPLAY_OFFSET);
-    oled_send_cmd(0x00);
-    oled_send_cmd(SSD1306_SET_START_LINE | 0x00);
-    oled_send_cmd(SSD1306_CHARGE_PUMP);
-    oled_send_cmd(0x14);
-    oled_send_cmd(SSD1306_MEMORY_MODE);
-    oled_send_cmd(0x00);
-    oled_send_cmd(SSD1306_SEG_REMAP | 0x01);
-    oled_send_cmd(SSD1306_COM_SCAN_DEC);
-    oled_send_cmd(SSD1306_SET_COM_PINS);
-    oled_send_cmd(0x12);
-    oled_send_cmd(SSD1306_SET_CONTRAST);
-    oled_send_cmd(0xCF);
-    oled_send_cmd(SSD1306_SET_PRECHARGE);
-    oled_send_cmd(0xF1);
-    oled_send_cmd(SSD1306_SET_VCOM_DETECT);
-    oled_send_cmd(0x40);
-    oled_send_cmd(SSD1306_DISPLAY_ALL_ON_RESUME);
-    oled_send_cmd(SSD1306_NORMAL_DISPLAY);
-    oled_send_cmd(SSD1306_DISPLAY_ON);
+    while (len > 0) {
+        size_t n = len < OLED_DATA_CHUNK ? len : OLED_DATA_CHUNK;
+        memcpy(buf + 1, data, n);
+        oled_bus_write(buf, n + 1);
+        bus_bytes += n + 2;
+        data += n;
+        len -= n;
+    }
+}
+
+// Inicializar o display. Em vez de uma espera fixa após ligar, repete a
+// sequência até o controlador responder (ACK) ou o prazo acabar.
+bool oled_init() {
+    uint64_t deadline = hal_time_us() + OLED_POWER_UP_TIMEOUT_MS * 1000ull;
+    bool ack;
+    while (!(ack = oled_send_cmd_list(oled_init_cmds, sizeof(oled_init_cmds))) &&
+           hal_time_us() < deadline) {
+        hal_sleep_us(500);
+    }
+
+    // Conteúdo da RAM do painel é indefinido após ligar: reenvia tudo
+    front_valid = false;
+    oled_mark_all_dirty();
+    return ack;
 }
 
 // Limpar o display
 void oled_clear() {
+    PROF_SCOPE(PROF_OLED_CLEAR);
+    // Só as colunas com pixels acesos precisam ser reenviadas
+    for (int p = 0; p < OLED_PAGES; p++) {
+        const uint8_t *row = &oled_buffer[p * OLED_WIDTH];
+        int x0 = 0;
+        int x1 = OLED_WIDTH - 1;
+        while (x0 <= x1 && row[x0] == 0) x0++;
+        while (x1 >= x0 && row[x1] == 0) x1--;
+        if (x0 <= x1) {
+            mark_dirty(p, x0, x1);
+        }
+    }
     memset(oled_buffer, 0, sizeof(oled_buffer));
 }
 
-// Atualizar o display
+void oled_mark_all_dirty(void) {
+    for (int p = 0; p < OLED_PAGES; p++) {
+        mark_dirty(p, 0, OLED_WIDTH - 1);
+    }
+}
+
+// ===== TRANSFERÊNCIA ASSÍNCRONA (DMA) =====
+
+// Janela retangular da RAM do painel (colunas x0..x1, páginas p0..p1)
+typedef struct {
+    uint8_t x0, x1, p0, p1;
+} oled_window_t;
+
+static oled_window_t windows[OLED_PAGES];
+static int window_count;
+static int cur_window;           // Janela em envio
+static int cur_page;             // Página da janela em envio (-1 = comandos)
+static volatile bool busy;
+static bool present_requested;   // Quadro pendente aguardando o barramento
+static uint64_t start_us;
+static uint32_t last_update_us;
+static uint32_t bus_errors;
+static oled_update_cb_t update_cb;
+
+// Custo em bytes no barramento de uma janela
+static int window_cost(int x0, int x1, int p0, int p1) {
+    return OLED_WINDOW_OVERHEAD + (p1 - p0 + 1) * (x1 - x0 + 1 + 2);
+}
+
+// Reduz a região suja de cada página aos bytes que diferem do front buffer
+static void trim_dirty(void) {
+    for (int p = 0; p < OLED_PAGES; p++) {
+        const uint8_t *back = &oled_buffer[p * OLED_WIDTH];
+        const uint16_t *front = &oled_front[p * OLED_WIDTH];
+        int x0 = dirty_min[p];
+        int x1 = dirty_max[p];
+        while (x0 <= x1 && back[x0] == (uint8_t)front[x0]) x0++;
+        while (x1 >= x0 && back[x1] == (uint8_t)front[x1]) x1--;
+        dirty_min[p] = x0 <= x1 ? x0 : OLED_WIDTH;
+        dirty_max[p] = x0 <= x1 ? x1 : -1;
+    }
+}
+
+// Agrupa as páginas sujas em janelas, juntando vizinhas quando custa menos bytes
+static void plan_windows(void) {
+    window_count = 0;
+    int run_p0 = -1, run_p1 = -1, run_x0 = 0, run_x1 = 0;
+    for (int p = 0; p < OLED_PAGES; p++) {
+        if (dirty_min[p] > dirty_max[p]) continue;
+
+        int x0 = dirty_min[p];
+        int x1 = dirty_max[p];
+        if (run_p0 >= 0) {
+            int ux0 = x0 < run_x0 ? x0 : run_x0;
+            int ux1 = x1 > run_x1 ? x1 : run_x1;
+            int separate = window_cost(run_x0, run_x1, run_p0, run_p1) + window_cost(x0, x1, p, p);
+            if (window_cost(ux0, ux1, run_p0, p) <= separate) {
+                run_x0 = ux0;
+                run_x1 = ux1;
+                run_p1 = p;
+                continue;
+            }
+            windows[window_count++] = (oled_window_t){run_x0, run_x1, run_p0, run_p1};
+        }
+        run_p0 = run_p1 = p;
+        run_x0 = x0;
+        run_x1 = x1;
+    }
+    if (run_p0 >= 0) {
+        windows[window_count++] = (oled_window_t){run_x0, run_x1, run_p0, run_p1};
+    }
+}
+
+// Copia as janelas do back buffer para o front buffer como palavras IC_DATA_CMD.
+// A última palavra de cada fatia de página leva o bit STOP.
+static void stage_windows(void) {
+    for (int w = 0; w < window_count; w++) {
+        const oled_window_t *win = &windows[w];
+        for (int p = win->p0; p <= win->p1; p++) {
+            const uint8_t *src = &oled_buffer[p * OLED_WIDTH];
+            uint16_t *dst = &oled_front[p * OLED_WIDTH];
+            for (int x = win->x0; x <= win->x1; x++) {
+                dst[x] = src[x];
+            }
+            dst[win->x1] |= OLED_BUS_STOP;
+        }
+    }
+}
+
+static void start_transfer(void) {
+    if (front_valid) {
+        trim_dirty();
+    }
+    plan_windows();
+    stage_windows();
+    clear_dirty();
+    present_requested = false;
+
+    bus_bytes = 0;
+    start_us = hal_time_us();
+    cur_window = 0;
+    cur_page = -1;
+    busy = true;
+    oled_bus_begin();
+}
+
+static void finish_transfer(void) {
+    busy = false;
+    front_valid = true;
+    last_update_bytes = bus_bytes;
+    total_update_bytes += bus_bytes;
+    last_update_us = (uint32_t)(hal_time_us() - start_us);
+    if (update_cb) {
+        update_cb();
+    }
+}
+
+// Aborto no barramento (ex.: display sem ACK): o painel fica em estado desconhecido
+static void abort_transfer(void) {
+    bus_errors++;
+    front_valid = false;
+    oled_mark_all_dirty();
+    finish_transfer();
+}
+
+bool oled_update_async(void) {
+    PROF_SCOPE(PROF_OLED_FLUSH);
+    present_requested = true;
+    if (busy) {
+        return false;             // Enviado ao fim da transferência atual
+    }
+    start_transfer();
+    oled_update_poll();
+    return true;
+}
+
+bool oled_update_poll(void) {
+    PROF_SCOPE(PROF_OLED_POLL);
+    if (!busy) {
+        return true;
+    }
+
+    if (oled_bus_take_abort()) {
+        abort_transfer();
+        return !busy;
+    }
+
+    // Alimenta o FIFO do I2C sem esperar: só avança quando há espaço
+    while (!oled_bus_dma_busy()) {
+        if (cur_window >= window_count) {
+            // Último byte saiu do FIFO e o mestre liberou o barramento
+            if (oled_bus_idle()) {
+                finish_transfer();
+                if (present_requested) {
+                    start_transfer();
+                    continue;
+                }
+            }
+            break;
+        }
+
+        const oled_window_t *win = &windows[cur_window];
+        if (cur_page < 0) {
+            // Comandos da janela em uma única transação (Co = 0)
+            if (oled_bus_space() < 7) break;
+            oled_bus_put(0x00);
+            oled_bus_put(SSD1306_COLUMN_ADDR);
+            oled_bus_put(win->x0);
+            oled_bus_put(win->x1);
+            oled_bus_put(SSD1306_PAGE_ADDR);
+            oled_bus_put(win->p0);
+            oled_bus_put(win->p1 | OLED_BUS_STOP);
+            bus_bytes += 8;
+            cur_page = win->p0;
+        } else {
+            // Byte de controle pela CPU; os dados saem direto do front buffer
+            if (oled_bus_space() < 1) break;
+            uint32_t len = win->x1 - win->x0 + 1;
+            oled_bus_put(0x40);
+            oled_bus_put_dma(&oled_front[cur_page * OLED_WIDTH + win->x0], len);
+            bus_bytes += len + 2;
+            if (++cur_page > win->p1) {
+                cur_window++;
+                cur_page = -1;
+            }
+        }
+    }
+    return !busy;
+}
+
+bool oled_update_busy(void) {
+    return busy;
+}
+
+// Liga/desliga o painel (a RAM do SSD1306 é preservada). Usa o barramento
+// de forma bloqueante, então recusa se houver quadro em transferência.
+bool oled_set_display_on(bool on) {
+    if (busy) {
+        return false;
+    }
+    return oled_send_cmd_list((const uint8_t[]){on ? SSD1306_DISPLAY_ON : SSD1306_DISPLAY_OFF}, 1);
+}
+
+void oled_set_update_callback(oled_update_cb_t cb) {
+    update_cb = cb;
+}
+
+// Atualizar o display (bloqueante: aguarda a transferência por DMA)
 void oled_update() {
-    oled_send_cmd(SSD1306_COLUMN_ADDR);
-    oled_send_cmd(0);
-    oled_send_cmd(OLED_WIDTH - 1);
-    oled_send_cmd(SSD1306_PAGE_ADDR);
-    oled_send_cmd(0);
-    oled_send_cmd(OLED_PAGES - 1);
-    
-    oled_send_data(oled_buffer, sizeof(oled_buffer));
+    PROF_SCOPE(PROF_OLED_UPDATE);
+    oled_update_async();
+    while (!oled_update_poll()) {
+        hal_idle();
+    }
+}
+
+uint32_t oled_get_last_update_us(void) {
+    return last_update_us;
+}
+
+uint32_t oled_get_bus_errors(void) {
+    return bus_errors;
+}
+
+uint32_t oled_get_last_update_bytes(void) {
+    return last_update_bytes;
+}
+
+uint32_t oled_get_total_update_bytes(void) {
+    return total_update_bytes;
+}
+
+// ===== NÚCLEO DE RASTERIZAÇÃO =====
+// As primitivas recortam uma vez e escrevem bytes inteiros do buffer
+// (8 linhas por página), sem passar por oled_set_pixel a cada ponto.
+
+// Máscara dos bits y0..y1 (0..7) dentro de uma página
+static inline uint8_t page_mask(int y0, int y1) {
+    return (uint8_t)((0xFF << y0) & (0xFF >> (7 - y1)));
+}
+
+// Aplica uma máscara vertical em colunas x0..x1 de uma página (já recortadas)
+static inline void fill_page_mask(int page, int x0, int x1, uint8_t mask, bool on) {
+    uint8_t *p = &oled_buffer[page * OLED_WIDTH + x0];
+    uint8_t *end = p + (x1 - x0);
+    if (on) {
+        while (p <= end) *p++ |= mask;
+    } else {
+        mask = ~mask;
+        while (p <= end) *p++ &= mask;
+    }
+    mark_dirty(page, x0, x1);
+}
+
+// Ponto sem verificação de limites (coordenadas já validadas pela primitiva)
+static inline void plot_fast(int x, int y, bool on) {
+    uint8_t *byte = &oled_buffer[(y >> 3) * OLED_WIDTH + x];
+    uint8_t mask = 1 << (y & 7);
+    if (on) {
+        *byte |= mask;
+    } else {
+        *byte &= ~mask;
+    }
+}
+
+// Verdadeiro se o retângulo [x0,x1]x[y0,y1] cabe inteiro na tela
+static inline bool box_inside(int x0, int y0, int x1, int y1) {
+    return x0 >= 0 && y0 >= 0 && x1 < OLED_WIDTH && y1 < OLED_HEIGHT;
+}
+
+// Marca como sujo o retângulo (já dentro da tela) de uma primitiva de contorno
+static void mark_box_dirty(int x0, int y0, int x1, int y1) {
+    for (int p = y0 >> 3; p <= (y1 >> 3); p++) {
+        mark_dirty(p, x0, x1);
+    }
+}
+
+// Segmento horizontal na linha y, colunas x0..x1
+void oled_fill_hspan(int x0, int x1, int y, bool on) {
+    if (y < 0 || y >= OLED_HEIGHT) return;
+    if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+    if (x0 < 0) x0 = 0;
+    if (x1 >= OLED_WIDTH) x1 = OLED_WIDTH - 1;
+    if (x0 > x1) return;
+    fill_page_mask(y >> 3, x0, x1, 1 << (y & 7), on);
+}
+
+// Segmento vertical na coluna x, linhas y0..y1 (um byte por página)
+void oled_fill_vspan(int x, int y0, int y1, bool on) {
+    oled_fill_rect(x, y0 < y1 ? y0 : y1, 1, abs(y1 - y0) + 1, on);
+}
+
+// Retângulo preenchido: uma máscara por página, aplicada a todas as colunas
+void oled_fill_rect(int x, int y, int w, int h, bool on) {
+    PROF_SCOPE(PROF_OLED_FILL);
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1;
+    int y1 = y + h - 1;
+    if (x1 >= OLED_WIDTH) x1 = OLED_WIDTH - 1;
+    if (y1 >= OLED_HEIGHT) y1 = OLED_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    for (int page = y0 >> 3; page <= (y1 >> 3); page++) {
+        int top = page == (y0 >> 3) ? (y0 & 7) : 0;
+        int bottom = page == (y1 >> 3) ? (y1 & 7) : 7;
+        fill_page_mask(page, x0, x1, page_mask(top, bottom), on);
+    }
+}
+
+// Acumula a largura máxima de cada par de linhas simétricas (cy ± dy) e só
+// as preenche quando dy muda: cada linha é escrita uma única vez
+typedef struct {
+    int cx, cy;
+    int dy;       // Linha pendente (-1 = nenhuma)
+    int half;     // Meia largura acumulada
+    bool on;
+} span_pair_t;
+
+static void span_pair_flush(span_pair_t *s) {
+    if (s->dy < 0) return;
+    oled_fill_hspan(s->cx - s->half, s->cx + s->half, s->cy + s->dy, s->on);
+    if (s->dy != 0) {
+        oled_fill_hspan(s->cx - s->half, s->cx + s->half, s->cy - s->dy, s->on);
+    }
+    s->dy = -1;
+}
+
+static void span_pair_add(span_pair_t *s, int dy, int half) {
+    if (dy != s->dy) {
+        span_pair_flush(s);
+        s->dy = dy;
+        s->half = half;
+    } else if (half > s->half) {
+        s->half = half;
+    }
 }
 
 // Definir um pixel
 void oled_set_pixel(int x, int y, bool on) {
-    if (x >= 0 && x < OLED_WIDTH && y >= 0 && y < OLED_HEIGHT) {
-        if (on) {
-            oled_buffer[x + (y / 8) * OLED_WIDTH] |= (1 << (y % 8));
-        } else {
-            oled_buffer[x + (y / 8) * OLED_WIDTH] &= ~(1 << (y % 8));
+    if ((unsigned)x < OLED_WIDTH && (unsigned)y < OLED_HEIGHT) {
+        uint8_t *byte = &oled_buffer[x + (y >> 3) * OLED_WIDTH];
+        uint8_t value = on ? (*byte | (1 << (y & 7))) : (*byte & ~(1 << (y & 7)));
+        if (value != *byte) {
+            *byte = value;
+            mark_dirty(y >> 3, x, x);
         }
     }
 }
@@ -84,20 +488,35 @@ void oled_draw_circle(int cx, int cy, int radius, bool filled, bool on) {
     int x = 0;
     int y = radius;
     int d = 3 - 2 * radius;
+
+    // Contorno inteiro na tela: pontos sem verificação, sujeira marcada uma vez
+    bool inside = box_inside(cx - radius, cy - radius, cx + radius, cy + radius);
+    if (!filled && inside) {
+        mark_box_dirty(cx - radius, cy - radius, cx + radius, cy + radius);
+    }
+
+    // Linhas cy ± y mudam devagar (acumuladas); linhas cy ± x são únicas
+    span_pair_t outer = {cx, cy, -1, 0, on};
     
     while (x <= y) {
         if (filled) {
             // Desenhar linhas horizontais para preencher
-            for (int i = cx - x; i <= cx + x; i++) {
-                oled_set_pixel(i, cy + y, on);
-                oled_set_pixel(i, cy - y, on);
+            span_pair_add(&outer, y, x);
+            oled_fill_hspan(cx - y, cx + y, cy + x, on);
+            if (x != 0) {
+                oled_fill_hspan(cx - y, cx + y, cy - x, on);
             }
-            for (int i = cx - y; i <= cx + y; i++) {
-                oled_set_pixel(i, cy + x, on);
-                oled_set_pixel(i, cy - x, on);
-            }
-        } else {
+        } else if (inside) {
             // Desenhar apenas o contorno
+            plot_fast(cx + x, cy + y, on);
+            plot_fast(cx - x, cy + y, on);
+            plot_fast(cx + x, cy - y, on);
+            plot_fast(cx - x, cy - y, on);
+            plot_fast(cx + y, cy + x, on);
+            plot_fast(cx - y, cy + x, on);
+            plot_fast(cx + y, cy - x, on);
+            plot_fast(cx - y, cy - x, on);
+        } else {
             oled_set_pixel(cx + x, cy + y, on);
             oled_set_pixel(cx - x, cy + y, on);
             oled_set_pixel(cx + x, cy - y, on);
@@ -116,18 +535,40 @@ void oled_draw_circle(int cx, int cy, int radius, bool filled, bool on) {
         }
         x++;
     }
+    span_pair_flush(&outer);
 }
 
 // Desenhar uma linha
 void oled_draw_line(int x0, int y0, int x1, int y1, bool on) {
+    // Retas horizontais e verticais viram spans
+    if (y0 == y1) {
+        oled_fill_hspan(x0, x1, y0, on);
+        return;
+    }
+    if (x0 == x1) {
+        oled_fill_vspan(x0, y0, y1, on);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
     int sx = x0 < x1 ? 1 : -1;
     int sy = y0 < y1 ? 1 : -1;
     int err = dx - dy;
+
+    int bx0 = x0 < x1 ? x0 : x1, bx1 = x0 < x1 ? x1 : x0;
+    int by0 = y0 < y1 ? y0 : y1, by1 = y0 < y1 ? y1 : y0;
+    bool inside = box_inside(bx0, by0, bx1, by1);
+    if (inside) {
+        mark_box_dirty(bx0, by0, bx1, by1);
+    }
     
     while (true) {
-        oled_set_pixel(x0, y0, on);
+        if (inside) {
+            plot_fast(x0, y0, on);
+        } else {
+            oled_set_pixel(x0, y0, on);
+        }
         
         if (x0 == x1 && y0 == y1) break;
         
@@ -143,6 +584,21 @@ void oled_draw_line(int x0, int y0, int x1, int y1, bool on) {
     }
 }
 
+// Pontos simétricos do contorno de uma elipse
+static inline void ellipse_points(int cx, int cy, int x, int y, bool inside, bool on) {
+    if (inside) {
+        plot_fast(cx + x, cy + y, on);
+        plot_fast(cx - x, cy + y, on);
+        plot_fast(cx + x, cy - y, on);
+        plot_fast(cx - x, cy - y, on);
+    } else {
+        oled_set_pixel(cx + x, cy + y, on);
+        oled_set_pixel(cx - x, cy + y, on);
+        oled_set_pixel(cx + x, cy - y, on);
+        oled_set_pixel(cx - x, cy - y, on);
+    }
+}
+
 // Desenhar elipse (para olhos e boca)
 void oled_draw_ellipse(int cx, int cy, int rx, int ry, bool filled, bool on) {
     int x = 0;
@@ -154,19 +610,19 @@ void oled_draw_ellipse(int cx, int cy, int rx, int ry, bool filled, bool on) {
     int p1 = ry2 - rx2 * ry + rx2 / 4;
     int dx = 0;
     int dy = tworx2 * y;
+
+    bool inside = box_inside(cx - rx, cy - ry, cx + rx, cy + ry);
+    if (!filled && inside) {
+        mark_box_dirty(cx - rx, cy - ry, cx + rx, cy + ry);
+    }
+    span_pair_t rows = {cx, cy, -1, 0, on};
     
     // Região 1
     while (dx < dy) {
         if (filled) {
-            for (int i = cx - x; i <= cx + x; i++) {
-                oled_set_pixel(i, cy + y, on);
-                oled_set_pixel(i, cy - y, on);
-            }
+            span_pair_add(&rows, y, x);
         } else {
-            oled_set_pixel(cx + x, cy + y, on);
-            oled_set_pixel(cx - x, cy + y, on);
-            oled_set_pixel(cx + x, cy - y, on);
-            oled_set_pixel(cx - x, cy - y, on);
+            ellipse_points(cx, cy, x, y, inside, on);
         }
         
         if (p1 < 0) {
@@ -183,18 +639,16 @@ void oled_draw_ellipse(int cx, int cy, int rx, int ry, bool filled, bool on) {
     }
     
     // Região 2
-    int p2 = ry2 * (x + 0.5) * (x + 0.5) + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
+    // ry2 * (x + 0.5)^2 em inteiros, truncado como a conversão de double para int
+    int p2 = ry2 * (x * x + x) + ry2 / 4 + rx2 * (y - 1) * (y - 1) - rx2 * ry2;
+    if (p2 < 0 && (ry2 & 3)) {
+        p2++;
+    }
     while (y >= 0) {
         if (filled) {
-            for (int i = cx - x; i <= cx + x; i++) {
-                oled_set_pixel(i, cy + y, on);
-                oled_set_pixel(i, cy - y, on);
-            }
+            span_pair_add(&rows, y, x);
         } else {
-            oled_set_pixel(cx + x, cy + y, on);
-            oled_set_pixel(cx - x, cy + y, on);
-            oled_set_pixel(cx + x, cy - y, on);
-            oled_set_pixel(cx - x, cy - y, on);
+            ellipse_points(cx, cy, x, y, inside, on);
         }
         
         if (p2 > 0) {
@@ -209,66 +663,215 @@ void oled_draw_ellipse(int cx, int cy, int rx, int ry, bool filled, bool on) {
             p2 += dx - dy + rx2;
         }
     }
+    span_pair_flush(&rows);
+}
+
+// ===== ARCOS EM ARITMÉTICA INTEIRA =====
+
+// sen(0..90 graus) em Q14 (16384 = 1.0)
+static const int16_t sin_q14[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+// Seno em Q14 para qualquer ângulo inteiro em graus
+static int sin_deg_q14(int deg) {
+    deg %= 360;
+    if (deg < 0) deg += 360;
+    if (deg <= 90)  return sin_q14[deg];
+    if (deg <= 180) return sin_q14[180 - deg];
+    if (deg <= 270) return -sin_q14[deg - 180];
+    return -sin_q14[360 - deg];
+}
+
+static inline int cos_deg_q14(int deg) {
+    return sin_deg_q14(deg + 90);
 }
 
-// Desenhar arco para sorriso/tristeza
+// Setor angular [start, end] no sentido do ângulo crescente. Com y para
+// baixo, o ângulo cresce de +x para +y, como em x = cx + r*cos, y = cy + r*sin.
+typedef struct {
+    int sx, sy;      // Direção inicial (Q14)
+    int ex, ey;      // Direção final (Q14)
+    int sweep;       // Abertura em graus
+} arc_sector_t;
+
+static inline int cross(int ax, int ay, int bx, int by) {
+    return ax * by - ay * bx;
+}
+
+// Teste só com multiplicações inteiras (produto vetorial contra as bordas)
+static inline bool sector_contains(const arc_sector_t *s, int dx, int dy) {
+    if (s->sweep >= 360) {
+        return true;
+    }
+    if (s->sweep <= 180) {
+        return cross(s->sx, s->sy, dx, dy) >= 0 && cross(dx, dy, s->ex, s->ey) >= 0;
+    }
+    // Setor maior que meia volta: fora apenas do setor complementar aberto
+    return !(cross(s->ex, s->ey, dx, dy) > 0 && cross(dx, dy, s->sx, s->sy) > 0);
+}
+
+// Preenche os pontos do setor em dx0..dx1 de uma linha, agrupados em spans
+static void arc_row(const arc_sector_t *s, int cx, int cy, int dy, int dx0, int dx1, bool on) {
+    int run = 0;
+    bool in_run = false;
+    for (int dx = dx0; dx <= dx1; dx++) {
+        bool in = sector_contains(s, dx, dy);
+        if (in && !in_run) {
+            run = dx;
+            in_run = true;
+        } else if (!in && in_run) {
+            oled_fill_hspan(cx + run, cx + dx - 1, cy + dy, on);
+            in_run = false;
+        }
+    }
+    if (in_run) {
+        oled_fill_hspan(cx + run, cx + dx1, cy + dy, on);
+    }
+}
+
+// Arco espesso: anel entre os raios r_in e r_out (critério do ponto médio)
+// recortado pelo setor angular. Sem ponto flutuante e sem falhas no traço.
+void oled_draw_arc_thick(int cx, int cy, int radius, int start_angle, int end_angle,
+                         int thickness, bool on) {
+    if (thickness < 1) thickness = 1;
+    int r_in = radius - thickness / 2;       // Traço centrado no raio (par: meio pixel para dentro)
+    if (r_in < 0) r_in = 0;
+    int r_out = r_in + thickness - 1;
+
+    arc_sector_t s;
+    s.sweep = end_angle - start_angle;
+    if (s.sweep < 0) s.sweep += 360;
+    s.sx = cos_deg_q14(start_angle);
+    s.sy = sin_deg_q14(start_angle);
+    s.ex = cos_deg_q14(end_angle);
+    s.ey = sin_deg_q14(end_angle);
+
+    // Pixel (dx, dy) pertence ao anel se (2*r_in - 1)^2 < 4*(dx^2 + dy^2) <= (2*r_out + 1)^2
+    int outer_lim = (2 * r_out + 1) * (2 * r_out + 1);
+    int inner_lim = r_in > 0 ? (2 * r_in - 1) * (2 * r_in - 1) : -1;
+    int xo = r_out;
+    int xi = r_in;
+
+    for (int ady = 0; ady <= r_out; ady++) {
+        // Extensões horizontais dos dois discos só diminuem com |dy|
+        while (xo >= 0 && 4 * (xo * xo + ady * ady) > outer_lim) xo--;
+        while (xi >= 0 && 4 * (xi * xi + ady * ady) > inner_lim) xi--;
+        if (xo < 0) break;
+
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            int dy = sign * ady;
+            if (xi < 0) {
+                arc_row(&s, cx, cy, dy, -xo, xo, on);        // Linha sem furo
+            } else if (xi < xo) {
+                arc_row(&s, cx, cy, dy, -xo, -xi - 1, on);   // Lado esquerdo
+                arc_row(&s, cx, cy, dy, xi + 1, xo, on);     // Lado direito
+            }
+            if (ady == 0) break;
+        }
+    }
+}
+
+// Desenhar arco para sorriso/tristeza (traço de 2 pixels)
 void oled_draw_arc(int cx, int cy, int radius, int start_angle, int end_angle, bool on) {
-    for (int angle = start_angle; angle <= end_angle; angle++) {
-        float rad = angle * M_PI / 180.0;
-        int x = cx + (int)(radius * cos(rad));
-        int y = cy + (int)(radius * sin(rad));
-        oled_set_pixel(x, y, on);
-        
-        // Tornar a linha mais espessa
-        oled_set_pixel(x + 1, y, on);
-        oled_set_pixel(x, y + 1, on);
-        oled_set_pixel(x + 1, y + 1, on);
+    oled_draw_arc_thick(cx, cy, radius, start_angle, end_angle, 2, on);
+}
+
+// ===== SPRITES =====
+
+// Copia um bitmap página a página (memcpy por linha de página)
+void oled_blit_sprite(const oled_sprite_t *sprite, int x, int page) {
+    PROF_SCOPE(PROF_OLED_BLIT);
+    int src_x = 0;
+    int w = sprite->width;
+    if (x < 0) {
+        src_x = -x;
+        w += x;
+        x = 0;
+    }
+    if (x + w > OLED_WIDTH) {
+        w = OLED_WIDTH - x;
+    }
+    if (w <= 0) return;
+
+    for (int p = 0; p < sprite->pages; p++) {
+        int dst_page = page + p;
+        if (dst_page < 0 || dst_page >= OLED_PAGES) continue;
+        memcpy(&oled_buffer[dst_page * OLED_WIDTH + x],
+               &sprite->data[p * sprite->width + src_x], w);
+        mark_dirty(dst_page, x, x + w - 1);
     }
 }
 
-// Desenhar rosto feliz
-void draw_happy_face() {
-    oled_clear();
-    
-    // Rosto (círculo grande)
-    oled_draw_circle(64, 32, 28, false, true);
-    
-    // Olhos (círculos preenchidos)
-    oled_draw_circle(54, 24, 4, true, true);  // Olho esquerdo
-    oled_draw_circle(74, 24, 4, true, true);  // Olho direito
-    
-    // Sorriso (arco de 20 a 160 graus)
-    oled_draw_arc(64, 32, 15, 20, 160, true);
-    
-    // Bochechas (pequenos círculos)
-    oled_draw_circle(42, 35, 3, false, true);  // Bochecha esquerda
-    oled_draw_circle(86, 35, 3, false, true);  // Bochecha direita
-    
-    oled_update();
+// ===== TEXTO =====
+
+// Grava 'bits' sob 'mask' em uma faixa de colunas de uma página
+static inline void put_page_bits(int page, int x0, int x1, const uint8_t *bits, uint8_t mask) {
+    if (page < 0 || page >= OLED_PAGES) return;
+    uint8_t *dst = &oled_buffer[page * OLED_WIDTH + x0];
+    for (int x = x0; x <= x1; x++, dst++, bits++) {
+        *dst = (uint8_t)((*dst & ~mask) | (*bits & mask));
+    }
+    mark_dirty(page, x0, x1);
 }
 
-// Desenhar rosto triste
-void draw_sad_face() {
-    oled_clear();
-    
-    // Rosto (círculo grande)
-    oled_draw_circle(64, 32, 28, false, true);
-    
-    // Olhos tristes (elipses inclinadas)
-    oled_draw_ellipse(54, 24, 3, 5, true, true);  // Olho esquerdo
-    oled_draw_ellipse(74, 24, 3, 5, true, true);  // Olho direito
-    
-    // Sobrancelhas tristes
-    oled_draw_line(48, 18, 58, 20, true);  // Sobrancelha esquerda
-    oled_draw_line(70, 20, 80, 18, true);  // Sobrancelha direita
-    
-    // Boca triste (arco invertido de 200 a 340 graus)
-    oled_draw_arc(64, 48, 12, 200, 340, true);
-    
-    // Lágrimas
-    oled_draw_line(50, 28, 48, 35, true);  // Lágrima esquerda
-    oled_draw_line(48, 35, 46, 38, true);
-    oled_draw_circle(46, 39, 2, true, true);  // Gota
-    
-    oled_update();
-}
\ No newline at end of file
+// Glifo como sprite: linhas de página copiadas para o buffer. Fora do
+// alinhamento, cada linha do glifo se divide entre duas páginas com um
+// deslocamento e uma máscara.
+int oled_draw_char(const oled_font_t *font, int x, int y, char c, bool on) {
+    PROF_SCOPE(PROF_OLED_TEXT);
+    int adv = font->width + font->spacing;
+    int x0 = x < 0 ? 0 : x;
+    int x1 = x + adv - 1;
+    if (x1 >= OLED_WIDTH) x1 = OLED_WIDTH - 1;
+    if (x0 > x1 || y >= OLED_HEIGHT || y + font->pages * 8 <= 0) return x + adv;
+
+    const uint8_t *glyph = NULL;
+    if (c >= font->first && c <= font->last) {
+        glyph = &font->data[(c - font->first) * font->width * font->pages];
+    }
+    uint8_t inv = on ? 0x00 : 0xFF;
+    int page = y >> 3;                      // Piso também para y negativo
+    int shift = y & 7;
+    uint8_t row[OLED_WIDTH];
+    uint8_t low[OLED_WIDTH];
+    for (int p = 0; p < font->pages; p++, page++) {
+        // Linha de página do glifo (e o espaçamento) já recortada e invertida
+        int n = x1 - x0 + 1;
+        for (int i = 0; i < n; i++) {
+            int gx = x0 + i - x;
+            uint8_t b = glyph && gx < font->width ? glyph[p * font->width + gx] : 0;
+            row[i] = b ^ inv;
+        }
+        if (shift == 0) {
+            if (page >= 0 && page < OLED_PAGES) {
+                memcpy(&oled_buffer[page * OLED_WIDTH + x0], row, n);
+                mark_dirty(page, x0, x1);
+            }
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            low[i] = row[i] >> (8 - shift);
+            row[i] = (uint8_t)(row[i] << shift);
+        }
+        put_page_bits(page, x0, x1, row, (uint8_t)(0xFF << shift));
+        put_page_bits(page + 1, x0, x1, low, (uint8_t)(0xFF >> (8 - shift)));
+    }
+    return x + adv;
+}
+
+int oled_draw_text(const oled_font_t *font, int x, int y, const char *text, bool on) {
+    while (*text && x < OLED_WIDTH) {
+        x = oled_draw_char(font, x, y, *text++, on);
+    }
+    return x;
+}
@@ -4,17 +4,33 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
-#include <math.h>
+
 
 // Configurações do I2C
 #define I2C_PORT i2c1
 #define I2C_ADDR 0x3C  // Endereço do SSD1306
 
+// Frequência do barramento: 400 kHz (Fast-mode) ou 1 MHz (Fast-mode Plus).
+// Pode ser definida pelo CMake (-DOLED_I2C_BAUDRATE=...)
+#ifndef OLED_I2C_BAUDRATE
+#define OLED_I2C_BAUDRATE 400000
+#endif
+
+// Tempo máximo aguardando o controlador responder após ligar
+#define OLED_POWER_UP_TIMEOUT_MS 100
+
 // Configurações do display
 #define OLED_WIDTH 128
 #define OLED_HEIGHT 64
 #define OLED_PAGES (OLED_HEIGHT / 8)
 
+// Custo fixo de uma janela parcial: uma transação com 6 comandos
+#define OLED_WINDOW_OVERHEAD 8
+
+// Tamanho dos blocos de oled_send_data/oled_send_cmd_list (buffer na pilha)
+#define OLED_DATA_CHUNK 32
+#define OLED_CMD_CHUNK 32
+
 // Comandos SSD1306
 #define SSD1306_SET_CONTRAST 0x81
 #define SSD1306_DISPLAY_ALL_ON_RESUME 0xA4
@@ -36,11 +52,35 @@
 #define SSD1306_SET_START_LINE 0x40
 
 // Funções básicas do OLED
+uint32_t oled_i2c_init(uint32_t sda, uint32_t scl, uint32_t baudrate);
 void oled_send_cmd(uint8_t cmd);
+bool oled_send_cmd_list(const uint8_t *cmds, size_t len);   // false = sem ACK
 void oled_send_data(uint8_t *data, size_t len);
-void oled_init(void);
+bool oled_init(void);                // false = display não respondeu
 void oled_clear(void);
-void oled_update(void);
+void oled_update(void);             // Envia somente as janelas alteradas (bloqueante)
+void oled_mark_all_dirty(void);      // Força o reenvio do quadro inteiro
+
+// Atualização assíncrona: o DMA envia o front buffer enquanto o desenho
+// continua no back buffer. Se o barramento estiver ocupado, o quadro mais
+// recente é enviado assim que a transferência atual terminar.
+typedef void (*oled_update_cb_t)(void);
+bool oled_update_async(void);        // false = ocupado, quadro ficou pendente
+bool oled_update_poll(void);         // Avança a transferência; true = ocioso
+bool oled_update_busy(void);
+bool oled_set_display_on(bool on);  // false = barramento ocupado (tente de novo)
+void oled_set_update_callback(oled_update_cb_t cb);  // Chamado ao concluir (dentro do poll)
+
+// Estatísticas do barramento (bytes, incluindo o byte de endereço I2C)
+uint32_t oled_get_last_update_bytes(void);
+uint32_t oled_get_total_update_bytes(void);
+uint32_t oled_get_last_update_us(void);   // Duração da última transferência
+uint32_t oled_get_bus_errors(void);       // Transferências abortadas (sem ACK)
+
+// Núcleo de rasterização (recorte uma vez, bytes inteiros por página)
+void oled_fill_hspan(int x0, int x1, int y, bool on);
+void oled_fill_vspan(int x, int y0, int y1, bool on);
+void oled_fill_rect(int x, int y, int w, int h, bool on);
 
 // Funções de desenho
 void oled_set_pixel(int x, int y, bool on);
@@ -48,9 +88,39 @@ void oled_draw_circle(int cx, int cy, int radius, bool filled, bool on);
 void oled_draw_line(int x0, int y0, int x1, int y1, bool on);
 void oled_draw_ellipse(int cx, int cy, int rx, int ry, bool filled, bool on);
 void oled_draw_arc(int cx, int cy, int radius, int start_angle, int end_angle, bool on);
+void oled_draw_arc_thick(int cx, int cy, int radius, int start_angle, int end_angle,
+                         int thickness, bool on);
+
+// Bitmap 1bpp no formato da RAM do painel: 'pages' linhas de 'width' bytes,
+// cada byte = 8 pixels verticais. Declarado const, fica na flash.
+typedef struct {
+    uint8_t width;
+    uint8_t pages;
+    const uint8_t *data;
+} oled_sprite_t;
+
+void oled_blit_sprite(const oled_sprite_t *sprite, int x, int page);
+
+// Fonte de largura fixa no mesmo formato: cada glifo tem 'pages' linhas de
+// 'width' bytes (colunas de 8 pixels), então desenhar é copiar bytes, com
+// deslocamento quando 'y' não cai no início de uma página. Caracteres fora
+// de first..last saem em branco. Ver oled_font.h.
+typedef struct {
+    uint8_t width;
+    uint8_t pages;
+    uint8_t spacing;            // Colunas vazias depois de cada glifo
+    char first;
+    char last;
+    const uint8_t *data;        // Glifo i em data[i * width * pages]
+} oled_font_t;
+
+// Desenha sobre a célula inteira (fundo apagado; 'on' = false inverte) e
+// retorna a coluna do próximo caractere
+int oled_draw_char(const oled_font_t *font, int x, int y, char c, bool on);
+int oled_draw_text(const oled_font_t *font, int x, int y, const char *text, bool on);
 
-// Funções para desenhar faces
-void draw_happy_face(void);
-void draw_sad_face(void);
+static inline int oled_text_advance(const oled_font_t *font) {
+    return font->width + font->spacing;
+}
 
 #endif // OLED_SSD1306_H
\ No newline at end of file
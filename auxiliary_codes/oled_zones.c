@@ -0,0 +1,114 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "oled_zones.h"                     // Painel das zonas
+#include "irrigation_fsm.h"                 // Estados mostrados na linha de baixo
+#include "prof.h"                           // Tempo de desenho do painel
+
+#define STATUS_Y (OLED_ZONES_BAR_HEIGHT + 2)
+#define STATUS_H 5
+#define MAX_BAR_W 10
+#define LEVEL_SUBSTEPS 4            // Nível em quartos de linha
+#define LEVEL_HYSTERESIS 3          // 3/4 de linha: o ruído na borda de um pixel não redesenha
+
+typedef struct {
+    uint8_t level;              // Linhas preenchidas da barra
+    uint8_t dry_level;          // Altura da marca do limiar
+    uint8_t state;
+    bool waiting;
+} zone_view_t;
+
+static zone_view_t shown[OLED_ZONES_MAX];   // O que está no back buffer
+static zone_view_t wanted[OLED_ZONES_MAX];
+static uint32_t zone_count;
+static uint32_t bar_w;
+static bool all_dirty;
+
+// Água → quartos de linha preenchidos
+static uint32_t level_of(uint16_t water_cml, uint16_t full_cml) {
+    if (full_cml == 0) {
+        return 0;
+    }
+    if (water_cml > full_cml) {
+        water_cml = full_cml;
+    }
+    return (uint32_t)water_cml * OLED_ZONES_BAR_HEIGHT * LEVEL_SUBSTEPS / full_cml;
+}
+
+void oled_zones_init(uint32_t count) {
+    zone_count = count > OLED_ZONES_MAX ? OLED_ZONES_MAX : count;
+    bar_w = zone_count ? OLED_ZONES_WIDTH / zone_count : 0;
+    if (bar_w > MAX_BAR_W) bar_w = MAX_BAR_W;
+    for (uint32_t i = 0; i < zone_count; i++) {
+        wanted[i] = (zone_view_t){0};
+    }
+    all_dirty = true;
+}
+
+void oled_zones_set(uint32_t zone, uint16_t water_cml, uint16_t dry_cml, uint16_t full_cml,
+                    uint8_t state, bool waiting) {
+    if (zone >= zone_count) {
+        return;
+    }
+    zone_view_t *v = &wanted[zone];
+    int32_t level = (int32_t)level_of(water_cml, full_cml);
+    int32_t diff = level - v->level * LEVEL_SUBSTEPS;
+    if (diff >= LEVEL_HYSTERESIS || diff <= -LEVEL_HYSTERESIS) {
+        v->level = (uint8_t)((level + LEVEL_SUBSTEPS / 2) / LEVEL_SUBSTEPS);
+    }
+    v->dry_level = (uint8_t)((level_of(dry_cml, full_cml) + LEVEL_SUBSTEPS / 2) / LEVEL_SUBSTEPS);
+    v->state = state;
+    v->waiting = waiting;
+}
+
+static void draw_zone(uint32_t zone, const zone_view_t *v) {
+    int x = OLED_ZONES_X + (int)(zone * bar_w);
+    int w = (int)bar_w - 1;                 // Uma coluna de separação
+    int fill_y = OLED_ZONES_BAR_HEIGHT - v->level;
+
+    // --- Barra: vazia em cima, água embaixo ---
+    oled_fill_rect(x, 0, w, fill_y, false);
+    oled_fill_rect(x, fill_y, w, v->level, true);
+    // Marca do limiar invertida: visível com a barra cheia ou vazia
+    int tick_y = OLED_ZONES_BAR_HEIGHT - v->dry_level;
+    if (tick_y >= OLED_ZONES_BAR_HEIGHT) tick_y = OLED_ZONES_BAR_HEIGHT - 1;
+    oled_fill_hspan(x, x + w - 1, tick_y, tick_y < fill_y);
+
+    // --- Estado ---
+    oled_fill_rect(x, STATUS_Y, w, STATUS_H, false);
+    switch (v->state) {
+        case IRRIGATION_DOSING:
+            oled_fill_rect(x, STATUS_Y, w, STATUS_H, true);
+            break;
+        case IRRIGATION_SOAKING:
+            oled_fill_rect(x, STATUS_Y + STATUS_H / 2 + 1, w, STATUS_H / 2, true);
+            break;
+        case IRRIGATION_LOCKOUT:
+            oled_fill_hspan(x, x + w - 1, STATUS_Y, true);
+            oled_fill_hspan(x, x + w - 1, STATUS_Y + STATUS_H - 1, true);
+            oled_fill_vspan(x, STATUS_Y, STATUS_Y + STATUS_H - 1, true);
+            oled_fill_vspan(x + w - 1, STATUS_Y, STATUS_Y + STATUS_H - 1, true);
+            break;
+        default:
+            if (v->waiting) {
+                oled_set_pixel(x + w / 2, STATUS_Y + STATUS_H / 2, true);
+            }
+            break;
+    }
+}
+
+bool oled_zones_draw(void) {
+    PROF_SCOPE(PROF_ZONES_DRAW);
+    bool changed = false;
+    for (uint32_t i = 0; i < zone_count; i++) {
+        zone_view_t *s = &shown[i];
+        const zone_view_t *v = &wanted[i];
+        if (!all_dirty && s->level == v->level && s->dry_level == v->dry_level &&
+            s->state == v->state && s->waiting == v->waiting) {
+            continue;
+        }
+        draw_zone(i, v);
+        *s = *v;
+        changed = true;
+    }
+    all_dirty = false;
+    return changed;
+}
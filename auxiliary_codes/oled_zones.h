@@ -0,0 +1,28 @@
+#ifndef OLED_ZONES_H
+#define OLED_ZONES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "oled_ssd1306.h"
+
+// Painel das zonas à direita da face (colunas 96..127): uma barra de
+// umidade por zona, com uma marca no limiar de solo seco, e uma linha de
+// estado embaixo: cheia = irrigando, meia = encharcando, ponto = esperando
+// a vez da bomba, contorno = bloqueada.
+
+#define OLED_ZONES_X 96
+#define OLED_ZONES_WIDTH (OLED_WIDTH - OLED_ZONES_X)
+#define OLED_ZONES_MAX 16
+#define OLED_ZONES_BAR_HEIGHT 56    // Linhas 0..55; estado nas linhas 58..62
+
+void oled_zones_init(uint32_t count);
+
+// Atualiza os dados de uma zona (desenha só em oled_zones_draw). Água em
+// centésimos de mL; 'full_cml' = barra cheia.
+void oled_zones_set(uint32_t zone, uint16_t water_cml, uint16_t dry_cml, uint16_t full_cml,
+                    uint8_t state, bool waiting);
+
+// Redesenha as zonas que mudaram de nível ou estado; true = back buffer alterado
+bool oled_zones_draw(void);
+
+#endif // OLED_ZONES_H
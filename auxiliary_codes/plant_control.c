@@ -0,0 +1,188 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "plant_control.h"                  // Controle compartilhado (firmware e simulador)
+#include "pump.h"                           // Bomba (GPIO no Pico, virtual no host)
+#include "prof.h"                           // Tempo do passo e do escalonador
+
+void plant_control_init(plant_zone_t *zone, uint32_t id) {
+    zone->cfg = &plant_zones[id];
+    zone->id = (uint8_t)id;
+    zone->has_reading = false;
+    zone->wait_since_us = 0;
+    zone->last_wait_us = 0;
+    zone->max_wait_us = 0;
+    const irrigation_config_t config = {
+        .dose_ms = PUMP_DOSE_MS,
+        .soak_ms = SOAK_MS,
+        .lockout_ms = LOCKOUT_MS,
+        .max_doses = MAX_DOSES,
+    };
+    irrigation_fsm_init(&zone->fsm, &config);
+    const dose_config_t dose = {
+        .mode = DOSE_MODE,
+        .target_cml = zone->cfg->target_water_cml,
+        .tolerance_cml = DOSE_TOLERANCE_CML,
+        .settle_cml = DOSE_SETTLE_CML,
+        .min_dose_ms = DOSE_MIN_MS,
+        .max_dose_ms = PUMP_DOSE_MS,
+        .min_soak_ms = SOAK_MIN_MS,
+        .kp_q8 = DOSE_KP_Q8,
+        .ki_q8 = DOSE_KI_Q8,
+        .gain0_q8 = DOSE_GAIN0_Q8,
+        .delay0_ms = DOSE_DELAY0_MS,
+    };
+    dose_control_init(&zone->dose, &dose);
+    plant_control_set_calib(zone, &soil_calib_default);
+}
+
+void plant_control_set_calib(plant_zone_t *zone, const soil_calib_t *calib) {
+    zone->calib = *calib;
+    zone->fsm.cfg.dry_counts = soil_calib_counts_for(calib, zone->cfg->dry_water_cml);
+    zone->fsm.cfg.wet_counts = soil_calib_counts_for(calib, zone->cfg->wet_water_cml);
+}
+
+void plant_control_sampler_config(uint32_t zone_count, adc_sampler_config_t *out) {
+    *out = (adc_sampler_config_t){.mux_input = ADC_SAMPLER_NO_MUX};
+    for (uint32_t i = 0; i < zone_count; i++) {
+        const plant_zone_config_t *z = &plant_zones[i];
+        out->input_mask |= 1u << z->adc_input;
+        if (z->mux_channel != ADC_SAMPLER_NO_MUX) {
+            out->mux_input = z->adc_input;
+            if (z->mux_channel >= out->mux_channels) {
+                out->mux_channels = z->mux_channel + 1;
+            }
+        }
+    }
+}
+
+int plant_control_find_zone(const plant_zone_t *zones, uint32_t count,
+                            const adc_sampler_reading_t *reading) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (zones[i].cfg->adc_input == reading->input && zones[i].cfg->mux_channel == reading->mux) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+float plant_control_voltage(const adc_sampler_reading_t *reading) {
+    return reading->value * ADC_VREF / (float)((1u << reading->bits) - 1);
+}
+
+bool plant_control_step(plant_zone_t *zone, const adc_sampler_reading_t *reading,
+                        uint64_t now_us, uint32_t *pump_off_latency_us) {
+    PROF_SCOPE(PROF_CONTROL_STEP);
+    irrigation_fsm_t *fsm = &zone->fsm;
+    irrigation_state_t before = fsm->state;
+    zone->reading = *reading;
+    zone->has_reading = true;
+    *pump_off_latency_us = 0;
+    uint16_t counts = soil_calib_counts(reading->value, reading->bits);
+
+    // Entradas da dosagem para a máquina; a duração só quando a dose vai começar
+    dose_control_t *dc = &zone->dose;
+    dose_control_observe(dc, soil_calib_water(&zone->calib, counts), now_us);
+    fsm->soak_done = before == IRRIGATION_SOAKING && dose_control_settled(dc, now_us);
+    fsm->on_target = dose_control_on_target(dc);
+    if (fsm->dose_granted) {
+        fsm->next_dose_ms = dose_control_next_dose_ms(dc);
+    }
+    if (!irrigation_fsm_update(fsm, counts, now_us)) {
+        return false;
+    }
+
+    if (fsm->pump_on) {
+        pump_start(zone->id, fsm->dose_ms);   // Alarme desliga mesmo se o laço travar
+    } else if (pump_is_on(zone->id)) {
+        pump_stop(zone->id);
+    }
+
+    // Transições para o modelo e o resumo do ciclo
+    if (before == IRRIGATION_DOSING) {
+        dose_control_dose_ended(dc, now_us);
+    }
+    if (before == IRRIGATION_SOAKING) {
+        dose_control_soak_ended(dc, fsm->soak_done, now_us);
+    }
+    if (fsm->state == IRRIGATION_DOSING) {
+        dose_control_dose_started(dc, now_us);
+    } else if (fsm->state == IRRIGATION_IDLE || fsm->state == IRRIGATION_LOCKOUT) {
+        dose_control_cycle_ended(dc, fsm->state == IRRIGATION_LOCKOUT, now_us);
+    }
+    // Latência entre a amostra que cruzou o limiar e a bomba desligada
+    if (before == IRRIGATION_DOSING && fsm->reason != IRRIGATION_REASON_TIMEOUT) {
+        *pump_off_latency_us = (uint32_t)(pump_last_off_us(zone->id) - reading->timestamp_us);
+    }
+    return true;
+}
+
+bool plant_control_take_cycle(plant_zone_t *zone, dose_cycle_report_t *out) {
+    if (!zone->dose.cycle_done) {
+        return false;
+    }
+    zone->dose.cycle_done = false;
+    *out = zone->dose.cycle;
+    return true;
+}
+
+void plant_control_schedule(plant_zone_t *zones, uint32_t count, uint32_t budget_ma,
+                            uint64_t now_us) {
+    PROF_SCOPE(PROF_SCHEDULE);
+    // Corrente comprometida: bombas ligadas e doses liberadas ainda não iniciadas
+    uint32_t used_ma = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        plant_zone_t *z = &zones[i];
+        if (!z->fsm.dose_wanted) {
+            z->fsm.dose_granted = false;    // Liberação não usada (solo deixou de estar seco)
+            z->wait_since_us = 0;
+        } else if (z->wait_since_us == 0) {
+            z->wait_since_us = now_us ? now_us : 1;
+        }
+        if (pump_is_on(z->id) || z->fsm.dose_granted) {
+            used_ma += z->cfg->pump_ma;
+        }
+    }
+
+    // Ordem de chegada sem ultrapassagem: se o mais antigo não cabe, os
+    // seguintes também esperam (uma bomba grande não fica sem vez)
+    while (true) {
+        plant_zone_t *oldest = NULL;
+        for (uint32_t i = 0; i < count; i++) {
+            plant_zone_t *z = &zones[i];
+            if (z->fsm.dose_wanted && !z->fsm.dose_granted &&
+                (!oldest || z->wait_since_us < oldest->wait_since_us)) {
+                oldest = z;
+            }
+        }
+        if (!oldest || used_ma + oldest->cfg->pump_ma > budget_ma) {
+            break;
+        }
+        oldest->fsm.dose_granted = true;
+        used_ma += oldest->cfg->pump_ma;
+        oldest->last_wait_us = (uint32_t)(now_us - oldest->wait_since_us);
+        if (oldest->last_wait_us > oldest->max_wait_us) {
+            oldest->max_wait_us = oldest->last_wait_us;
+        }
+    }
+}
+
+uint32_t plant_control_mux_focus(const plant_zone_t *zones, uint32_t count) {
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const irrigation_fsm_t *fsm = &zones[i].fsm;
+        // Encharcando também: a estimativa do atraso do sensor precisa das
+        // leituras do pulso inteiro, sem buracos que reiniciem o filtro
+        if ((fsm->state == IRRIGATION_DOSING || fsm->state == IRRIGATION_SOAKING ||
+             fsm->dose_granted) &&
+            zones[i].cfg->mux_channel != ADC_SAMPLER_NO_MUX) {
+            mask |= 1u << zones[i].cfg->mux_channel;
+        }
+    }
+    return mask;
+}
+
+const oled_animation_t *plant_control_face(irrigation_state_t state) {
+    if (state == IRRIGATION_DOSING || state == IRRIGATION_SOAKING) {
+        return &anim_sad_tears;
+    }
+    return &anim_happy_blink;
+}
@@ -0,0 +1,129 @@
+#ifndef PLANT_CONTROL_H
+#define PLANT_CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "irrigation_fsm.h"
+#include "adc_sampler.h"
+#include "oled_anim.h"
+#include "pump.h"
+#include "soil_calib.h"
+#include "dose_control.h"
+
+// Lógica de controle compartilhada pelo firmware e pelo simulador (host/):
+// leitura → dosagem adaptativa e máquina de estados → bomba, o escalonador que reparte a fonte
+// entre as bombas das zonas, e a face mostrada em cada estado.
+
+// ===== Parâmetros de Sistema =====
+// Limiares em água (centésimos de mL no copo de referência); cada sensor os
+// converte para contagens pela sua calibração (soil_calib.h)
+#define SOIL_DRY_WATER_CML 1200     // Menos de 12 mL = solo seco (1.44V na curva padrão)
+#define SOIL_WET_WATER_CML 2000     // Mais de 20 mL = encharcado, não mata a planta (0.58V)
+#define SOIL_TARGET_WATER_CML 1500  // Alvo de cada ciclo de irrigação (15 mL)
+#define LOCKOUT_MS 60000            // Bloqueio da bomba após encharcar o solo
+#define MAX_DOSES 5                 // Doses consecutivas antes de bloquear (sensor/reservatório com falha)
+
+// Dosagem adaptativa (dose_control.h)
+#ifndef DOSE_MODE
+#define DOSE_MODE DOSE_MODE_MODEL   // Ou DOSE_MODE_PI
+#endif
+#define DOSE_MIN_MS 200             // Dose mais curta (partida da bomba)
+#define PUMP_DOSE_MS 9000           // Dose mais longa (segurança, também no alarme da bomba)
+#define DOSE_TOLERANCE_CML 50       // Ciclo termina a 0.5 mL do alvo
+#define DOSE_SETTLE_CML 20          // Subida de 0.2 mL: a água ainda está chegando ao sensor
+#define SOAK_MIN_MS 2000            // Encharcamento mínimo após cada dose
+#define SOAK_MS 120000              // Encharcamento máximo, se a leitura não assentar
+#define DOSE_KP_Q8 154              // PI: 60% do erro por dose
+#define DOSE_KI_Q8 64               // PI: 25% do erro residual acumulado
+#define DOSE_GAIN0_Q8 (100u * 256u) // Modelo inicial: 1 mL por segundo de bomba (curto de propósito)
+#define DOSE_DELAY0_MS 10000        // Modelo inicial: 10 s até a água chegar ao sensor
+#define ADC_VREF 3.3f               // Referência do ADC (só relatórios)
+
+// Taxa do controle (CMake: -DPICO_PLANT_CONTROL_HZ=10). Cada entrada do ADC
+// entrega uma leitura por volta, até 100 Hz (256 amostras a 25.6 kHz): a fila
+// do sampler nunca acumula mais que uma volta
+#ifndef PICO_PLANT_CONTROL_HZ
+#define PICO_PLANT_CONTROL_HZ 100
+#endif
+#if PICO_PLANT_CONTROL_HZ < 1 || PICO_PLANT_CONTROL_HZ > 1000
+#error "PICO_PLANT_CONTROL_HZ: 1..1000"
+#endif
+#define PLANT_CONTROL_PERIOD_US (1000000u / PICO_PLANT_CONTROL_HZ)
+#define PLANT_SENSE_HZ (PICO_PLANT_CONTROL_HZ < 100 ? PICO_PLANT_CONTROL_HZ : 100)
+#define PLANT_ADC_RATE_HZ ((uint32_t)PLANT_SENSE_HZ << ADC_SAMPLER_DEFAULT_OVERSAMPLE)  // Por entrada
+
+// ===== Zonas =====
+#define PLANT_MAX_ZONES PUMP_MAX    // ADC0, ADC1 e 8 canais do multiplexador no ADC2
+#ifndef PLANT_ZONE_COUNT
+#define PLANT_ZONE_COUNT 1          // Zonas em uso (CMake: -DPICO_PLANT_ZONES=8)
+#endif
+#define PUMP_SUPPLY_BUDGET_MA 600   // Corrente da fonte reservada às bombas
+
+// Uma linha da tabela de zonas (plant_zones.c)
+typedef struct {
+    uint8_t adc_input;          // ADC0..ADC2
+    uint8_t mux_channel;        // Canal do multiplexador (ADC_SAMPLER_NO_MUX = direto)
+    uint8_t pump_gpio;
+    uint16_t pump_ma;           // Corrente da bomba ligada
+    uint16_t dry_water_cml;     // Limiares próprios do vaso (água)
+    uint16_t wet_water_cml;
+    uint16_t target_water_cml;  // Alvo dos ciclos de irrigação
+} plant_zone_config_t;
+
+extern const plant_zone_config_t plant_zones[PLANT_MAX_ZONES];
+
+// Estado de uma zona em execução
+typedef struct {
+    const plant_zone_config_t *cfg;
+    uint8_t id;                 // Índice na tabela = id da bomba
+    irrigation_fsm_t fsm;
+    dose_control_t dose;        // Duração das doses e modelo do vaso
+    soil_calib_t calib;         // Cópia da calibração do sensor (contagens → água)
+    adc_sampler_reading_t reading;  // Última leitura
+    bool has_reading;
+    uint64_t wait_since_us;     // Pedido de dose pendente desde (0 = nenhum)
+    uint32_t last_wait_us;      // Espera da dose mais recente
+    uint32_t max_wait_us;
+} plant_zone_t;
+
+// Começa com a calibração padrão (soil_calib_default)
+void plant_control_init(plant_zone_t *zone, uint32_t id);
+
+// Guarda a calibração do sensor e converte os limiares da zona para contagens
+void plant_control_set_calib(plant_zone_t *zone, const soil_calib_t *calib);
+
+// Aquisição que cobre as entradas e canais da tabela
+void plant_control_sampler_config(uint32_t zone_count, adc_sampler_config_t *out);
+
+// Zona da leitura (pela entrada e canal do multiplexador); -1 = nenhuma
+int plant_control_find_zone(const plant_zone_t *zones, uint32_t count,
+                            const adc_sampler_reading_t *reading);
+
+// Tensão do sensor a partir de uma leitura sobreamostrada (relatórios)
+float plant_control_voltage(const adc_sampler_reading_t *reading);
+
+// Avança a dosagem e a máquina de estados da zona com a leitura e aplica a
+// saída na sua bomba; true = estado mudou. '*pump_off_latency_us' recebe o
+// tempo entre a amostra que cruzou o limiar e a bomba desligada (0 se não
+// se aplica).
+bool plant_control_step(plant_zone_t *zone, const adc_sampler_reading_t *reading,
+                        uint64_t now_us, uint32_t *pump_off_latency_us);
+
+// Resumo do último ciclo de irrigação terminado, uma vez; false = nenhum novo
+bool plant_control_take_cycle(plant_zone_t *zone, dose_cycle_report_t *out);
+
+// Escalonador das bombas: libera doses pedidas sem passar de 'budget_ma'
+// somando as bombas ligadas e as já liberadas. Ordem de chegada: quem
+// espera há mais tempo vai primeiro e nenhuma zona fica sem vez. Chamar a
+// cada iteração, depois dos passos; a dose começa no próximo passo da zona.
+void plant_control_schedule(plant_zone_t *zones, uint32_t count, uint32_t budget_ma,
+                            uint64_t now_us);
+
+// Canais do multiplexador irrigando, encharcando ou prestes a irrigar
+// (para adc_sampler_set_mux_scan); 0 = nenhum, varre todos
+uint32_t plant_control_mux_focus(const plant_zone_t *zones, uint32_t count);
+
+// Face do estado: triste enquanto irriga ou encharca
+const oled_animation_t *plant_control_face(irrigation_state_t state);
+
+#endif // PLANT_CONTROL_H
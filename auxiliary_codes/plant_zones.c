@@ -0,0 +1,31 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "plant_control.h"                  // Formato da tabela de zonas
+
+// ===== TABELA DE ZONAS =====
+// Um vaso por linha: sensor, bomba, limiares e alvo em água (a calibração de
+// cada sensor os converte para contagens). Os sensores capacitivos são
+// alimentados juntos pelo PWM do GPIO 2. ADC0 e ADC1 são lidos direto; os
+// demais passam pelo multiplexador analógico (74HC4051) na entrada ADC2,
+// com seleção S0..S2 nos GPIOs 3..5 (MUX_S0_GPIO em main.c). A zona 0 é a
+// instalação original de um vaso (GPIO 26 e bomba no GPIO 15).
+//
+// A firmware usa as PLANT_ZONE_COUNT primeiras linhas (-DPICO_PLANT_ZONES).
+
+const plant_zone_config_t plant_zones[PLANT_MAX_ZONES] = {
+    // ADC  mux                  bomba  mA   seco                encharcado          alvo
+    {0,     ADC_SAMPLER_NO_MUX,  15,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {1,     ADC_SAMPLER_NO_MUX,  16,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     0,                   17,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     1,                   18,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     2,                   19,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     3,                   20,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     4,                   21,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     5,                   22,    250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     6,                   6,     250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+    {2,     7,                   7,     250, SOIL_DRY_WATER_CML, SOIL_WET_WATER_CML, SOIL_TARGET_WATER_CML},
+};
+
+_Static_assert(sizeof(plant_zones) / sizeof(plant_zones[0]) == PLANT_MAX_ZONES,
+               "uma linha por bomba");
+_Static_assert(PLANT_ZONE_COUNT >= 1 && PLANT_ZONE_COUNT <= PLANT_MAX_ZONES,
+               "PICO_PLANT_ZONES fora da tabela");
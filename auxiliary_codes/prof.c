@@ -0,0 +1,116 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "prof.h"                           // Instrumentação do caminho quente
+#include <stdio.h>                          // Tabela em texto
+
+#define OVERHEAD_TRIES 8                    // Menor de algumas medições vazias
+
+// ===== HISTOGRAMAS =====
+// Memória fixa: PROF_COUNT × ~150 bytes, em RAM desde o boot
+static prof_hist_t hists[PROF_COUNT];
+static uint32_t overhead_cycles;
+
+static const char *const names[PROF_COUNT] = {
+    [PROF_CONTROL_LOOP] = "ctrl.loop",
+    [PROF_ADC_IRQ] = "adc.irq",
+    [PROF_CONTROL_STEP] = "ctrl.step",
+    [PROF_SCHEDULE] = "ctrl.schedule",
+    [PROF_IO_LOOP] = "io.loop",
+    [PROF_MESSAGES] = "io.messages",
+    [PROF_FLASH] = "io.flash",
+    [PROF_USB] = "io.usb",
+    [PROF_REPORT] = "io.report",
+    [PROF_OLED_CLEAR] = "oled.clear",
+    [PROF_OLED_FILL] = "oled.fill",
+    [PROF_OLED_BLIT] = "oled.blit",
+    [PROF_OLED_FLUSH] = "oled.flush",
+    [PROF_OLED_POLL] = "oled.poll",
+    [PROF_OLED_UPDATE] = "oled.update",
+    [PROF_ANIM_TICK] = "anim.tick",
+    [PROF_ZONES_DRAW] = "zones.draw",
+    [PROF_OLED_TEXT] = "oled.text",
+    [PROF_READOUT_DRAW] = "readout.draw",
+};
+
+static void record(prof_hist_t *h, uint32_t cycles) {
+    if (h->count == 0 || cycles < h->min) h->min = cycles;
+    if (cycles > h->max) h->max = cycles;
+    h->count++;
+    h->sum += cycles;
+    h->buckets[31 - __builtin_clz(cycles | 1u)]++;
+}
+
+void prof_record(prof_id_t id, uint32_t cycles) {
+    record(&hists[id], cycles);
+}
+
+void prof_init(void) {
+    hal_cycles_init();
+    // Custo de um escopo vazio: leitura do contador + registro num histograma à parte
+    static prof_hist_t scratch;
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < OVERHEAD_TRIES; i++) {
+        uint32_t start = hal_cycles();
+        record(&scratch, hal_cycles_elapsed(hal_cycles()));
+        uint32_t c = hal_cycles_elapsed(start);
+        if (c < best) best = c;
+    }
+    overhead_cycles = best;
+}
+
+const char *prof_name(prof_id_t id) {
+    return id < PROF_COUNT ? names[id] : "?";
+}
+
+// ===== RESUMO =====
+static uint32_t to_ns(uint64_t cycles) {
+    uint64_t ns = cycles * 1000000000ull / hal_cycles_hz();
+    return ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+// Limite superior do balde que contém o quantil (q em milésimos), sem passar do máximo
+static uint32_t quantile(const prof_hist_t *h, uint32_t q_milli) {
+    uint64_t rank = ((uint64_t)h->count * q_milli + 999) / 1000;
+    uint64_t seen = 0;
+    for (int b = 0; b < PROF_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            uint32_t upper = b == 31 ? UINT32_MAX : (2u << b) - 1;
+            return upper < h->max ? upper : h->max;
+        }
+    }
+    return h->max;
+}
+
+void prof_summary(prof_id_t id, prof_summary_t *out) {
+    const prof_hist_t *h = &hists[id];
+    *out = (prof_summary_t){0};
+    if (h->count == 0) {
+        return;
+    }
+    out->count = h->count;
+    out->min_ns = to_ns(h->min);
+    out->mean_ns = to_ns(h->sum / h->count);
+    out->p50_ns = to_ns(quantile(h, 500));
+    out->p99_ns = to_ns(quantile(h, 990));
+    out->max_ns = to_ns(h->max);
+}
+
+uint32_t prof_overhead_ns(void) {
+    return to_ns(overhead_cycles);
+}
+
+void prof_print(void) {
+    printf("Perfil (ns; p50/p99 pelo balde log2; cada medição custa ~%lu ns)\n",
+           (unsigned long)prof_overhead_ns());
+    printf("fase                    n       mín     média       p50       p99       máx\n");
+    for (int i = 0; i < PROF_COUNT; i++) {
+        prof_summary_t s;
+        prof_summary((prof_id_t)i, &s);
+        if (s.count == 0) {
+            continue;
+        }
+        printf("%-14s %10lu %9lu %9lu %9lu %9lu %9lu\n", names[i], (unsigned long)s.count,
+               (unsigned long)s.min_ns, (unsigned long)s.mean_ns, (unsigned long)s.p50_ns,
+               (unsigned long)s.p99_ns, (unsigned long)s.max_ns);
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef PROF_H
+#define PROF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"                        // Contador de ciclos
+
+// Instrumentação do caminho quente: cronômetros de escopo em cada fase dos
+// laços e em cada primitiva do OLED, com histogramas log2 de memória fixa
+// (mín/máx/média/p99). Ligada pelo CMake (-DPICO_PLANT_PROFILE=ON);
+// desligada, PROF_SCOPE não gera código nenhum.
+//
+// Cada fase tem um único escritor (um núcleo ou o IRQ do ADC); o despejo
+// lê sem trava e pode misturar uma medição em andamento.
+
+#ifndef PICO_PLANT_PROFILE
+#define PICO_PLANT_PROFILE 0
+#endif
+
+typedef enum {
+    // --- Core0: controle ---
+    PROF_CONTROL_LOOP = 0,      // Uma volta do laço, do despertar ao fim
+    PROF_ADC_IRQ,               // Decimação de um bloco do DMA (IRQ)
+    PROF_CONTROL_STEP,          // plant_control_step de uma leitura
+    PROF_SCHEDULE,              // Vez das bombas e foco do multiplexador
+    // --- Core1: display e USB ---
+    PROF_IO_LOOP,               // Uma tarefa do core1 (task_sched), sem a espera
+    PROF_MESSAGES,              // Mensagens do controle de uma volta
+    PROF_FLASH,                 // Histórico e calibração na flash
+    PROF_USB,                   // Comandos e telemetria/texto pela USB
+    PROF_REPORT,                // Relatório periódico
+    // --- Display ---
+    PROF_OLED_CLEAR,
+    PROF_OLED_FILL,             // oled_fill_rect
+    PROF_OLED_BLIT,             // oled_blit_sprite
+    PROF_OLED_FLUSH,            // oled_update_async: diferença do quadro e início do DMA
+    PROF_OLED_POLL,             // oled_update_poll
+    PROF_OLED_UPDATE,           // oled_update (bloqueante)
+    PROF_ANIM_TICK,
+    PROF_ZONES_DRAW,
+    PROF_OLED_TEXT,             // oled_draw_char (um glifo)
+    PROF_READOUT_DRAW,          // Leitura em texto à esquerda da face
+    PROF_COUNT
+} prof_id_t;
+
+#define PROF_BUCKETS 32         // Balde n: [2^n, 2^(n+1)) ciclos (o 0 inclui o zero)
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;               // Ciclos
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[PROF_BUCKETS];
+} prof_hist_t;
+
+// Resumo de uma fase em nanossegundos (percentis pelo limite do balde)
+typedef struct {
+    uint32_t count;
+    uint32_t min_ns;
+    uint32_t mean_ns;
+    uint32_t p50_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+} prof_summary_t;
+
+// Chamar uma vez em cada núcleo que mede (liga o contador de ciclos)
+void prof_init(void);
+
+void prof_record(prof_id_t id, uint32_t cycles);
+void prof_summary(prof_id_t id, prof_summary_t *out);
+const char *prof_name(prof_id_t id);
+
+// Custo de um PROF_SCOPE vazio, medido em prof_init (ns)
+uint32_t prof_overhead_ns(void);
+
+// Tabela em texto (printf) com as fases já medidas
+void prof_print(void);
+
+// --- Cronômetros ---
+// PROF_SCOPE mede do ponto de declaração ao fim do bloco (funções inteiras);
+// PROF_BEGIN/PROF_END, trechos seguidos de um mesmo laço
+#if PICO_PLANT_PROFILE
+typedef struct {
+    prof_id_t id;
+    uint32_t start;
+} prof_scope_t;
+
+static inline void prof_scope_end(prof_scope_t *s) {
+    prof_record(s->id, hal_cycles_elapsed(s->start));
+}
+
+#define PROF_CAT_(a, b) a##b
+#define PROF_CAT(a, b) PROF_CAT_(a, b)
+#define PROF_SCOPE(id) \
+    prof_scope_t PROF_CAT(prof_scope_, __LINE__) __attribute__((cleanup(prof_scope_end))) = {(id), hal_cycles()}
+#define PROF_BEGIN(var) uint32_t var = hal_cycles()
+#define PROF_END(id, var) prof_record((id), hal_cycles_elapsed(var))
+#else
+#define PROF_SCOPE(id) do { } while (0)
+#define PROF_BEGIN(var) do { } while (0)
+#define PROF_END(id, var) do { } while (0)
+#endif
+
+#endif // PROF_H
@@ -0,0 +1,69 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "pump.h"                           // Controle da bomba d'água
+#include "pico/stdlib.h"                    // GPIO e alarmes de hardware
+
+typedef struct {
+    uint32_t gpio;
+    volatile bool on;
+    volatile uint64_t off_us;
+    volatile alarm_id_t safety_alarm;       // Alarme que encerra a dose (0 = nenhum; escrito no IRQ)
+} pump_t;
+
+static pump_t pumps[PUMP_MAX];
+
+static void pump_off_now(pump_t *p) {
+    gpio_put(p->gpio, 0);
+    p->off_us = time_us_64();
+    p->on = false;
+}
+
+// Callback do alarme (contexto de IRQ): desliga sem depender do laço principal
+static int64_t pump_timeout_cb(alarm_id_t id, void *user_data) {
+    pump_t *p = user_data;
+    p->safety_alarm = 0;
+    pump_off_now(p);
+    return 0;                               // Não reagenda
+}
+
+void pump_init(uint32_t id, uint32_t gpio) {
+    pump_t *p = &pumps[id];
+    p->gpio = gpio;
+    gpio_init(gpio);
+    gpio_set_dir(gpio, GPIO_OUT);           // Configura GPIO como saída
+    pump_off_now(p);
+}
+
+void pump_start(uint32_t id, uint32_t max_on_ms) {
+    pump_t *p = &pumps[id];
+    if (p->safety_alarm > 0) {
+        cancel_alarm(p->safety_alarm);
+    }
+    p->on = true;
+    gpio_put(p->gpio, 1);
+    // 0 = prazo já passou e o callback já desligou; < 0 = sem alarme livre:
+    // sem desligamento garantido, a bomba não fica ligada
+    alarm_id_t alarme = add_alarm_in_ms(max_on_ms, pump_timeout_cb, p, true);
+    if (alarme < 0) {
+        p->safety_alarm = 0;
+        pump_off_now(p);
+        return;
+    }
+    p->safety_alarm = alarme;
+}
+
+void pump_stop(uint32_t id) {
+    pump_t *p = &pumps[id];
+    if (p->safety_alarm > 0) {
+        cancel_alarm(p->safety_alarm);
+        p->safety_alarm = 0;
+    }
+    pump_off_now(p);
+}
+
+bool pump_is_on(uint32_t id) {
+    return pumps[id].on;
+}
+
+uint64_t pump_last_off_us(uint32_t id) {
+    return pumps[id].off_us;
+}
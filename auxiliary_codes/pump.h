@@ -0,0 +1,22 @@
+#ifndef PUMP_H
+#define PUMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PUMP_MAX 10                 // Uma bomba por zona de irrigação
+
+// Bombas identificadas por 'id' (0 .. PUMP_MAX - 1), cada uma no seu GPIO
+void pump_init(uint32_t id, uint32_t gpio);
+
+// Liga a bomba; um alarme de hardware a desliga após 'max_on_ms'
+// mesmo que o laço principal esteja ocupado. Sem alarme livre no pool, a
+// bomba não liga (pump_is_on continua falso).
+void pump_start(uint32_t id, uint32_t max_on_ms);
+void pump_stop(uint32_t id);
+bool pump_is_on(uint32_t id);
+
+// Instante (time_us_64) do último desligamento
+uint64_t pump_last_off_us(uint32_t id);
+
+#endif // PUMP_H
@@ -45,6 +45,13 @@ void setup_pwm_power(uint gpio) {
                                                    // Funciona como fonte de alimentação DC
 }
 
+// Liga/desliga a alimentação do sensor sem reconfigurar o slice.
+// O novo nível vale a partir do próximo wrap (≤ 2.1 ms a 477 Hz),
+// tempo coberto pela estabilização do sensor.
+void set_pwm_power(uint gpio, bool on) {
+    pwm_set_gpio_level(gpio, on ? 65535 : 0);     // 100% ou 0% de duty cycle
+}
+
 /*
  * ===== DETALHES TÉCNICOS DO PWM =====
  * 
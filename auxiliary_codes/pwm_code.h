@@ -2,7 +2,9 @@
 #define PWM_CODE_H
 
 #include "pico/types.h"
+#include <stdbool.h>
 
 void setup_pwm_power(uint gpio);
+void set_pwm_power(uint gpio, bool on);   // Gating da alimentação do sensor
 
 #endif // PWM_CODE_H
\ No newline at end of file
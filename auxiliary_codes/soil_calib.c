@@ -0,0 +1,217 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "soil_calib.h"                     // Calibração dos sensores
+#include "flash_store.h"                    // Último setor da região da flash
+#include "telemetry_frame.h"                // telemetry_crc16
+#include <string.h>
+
+#define CALIB_MAGIC 0x4C43                  // "CL"
+#define CALIB_CRC_START 4                   // Depois de magic e crc
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;
+    uint16_t crc;                           // CRC-16 do resto do cabeçalho + tabelas
+    uint8_t sensors;
+    uint8_t points;                         // SOIL_CALIB_MAX_POINTS da gravação
+    uint16_t reserved;
+    soil_calib_t tables[SOIL_CALIB_MAX_SENSORS];
+} calib_store_t;
+
+_Static_assert(sizeof(calib_store_t) <= FLASH_STORE_SECTOR_SIZE, "calibração cabe num setor");
+
+// ===== TABELA PADRÃO =====
+const soil_calib_t soil_calib_default = {
+    .count = 5,
+    .counts = {
+        SOIL_CALIB_COUNTS_FROM_VOLTS(0.54),
+        SOIL_CALIB_COUNTS_FROM_VOLTS(0.58),
+        SOIL_CALIB_COUNTS_FROM_VOLTS(1.44),
+        SOIL_CALIB_COUNTS_FROM_VOLTS(1.66),
+        SOIL_CALIB_COUNTS_FROM_VOLTS(3.11),
+    },
+    .water_cml = {2100, 2000, 1200, 1100, 0},
+};
+
+// ===== CONVERSÕES =====
+// Interpolação inteira entre (x0, y0) e (x1, y1); 64 bits no produto
+static uint16_t lerp(uint16_t x, uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1) {
+    int64_t dy = (int64_t)y1 - y0;
+    return (uint16_t)(y0 + dy * ((int32_t)x - x0) / ((int32_t)x1 - x0));
+}
+
+uint16_t soil_calib_water(const soil_calib_t *c, uint16_t counts) {
+    if (counts <= c->counts[0]) {
+        return c->water_cml[0];
+    }
+    for (uint32_t i = 1; i < c->count; i++) {
+        if (counts <= c->counts[i]) {
+            return lerp(counts, c->counts[i - 1], c->counts[i], c->water_cml[i - 1], c->water_cml[i]);
+        }
+    }
+    return c->water_cml[c->count - 1];
+}
+
+uint16_t soil_calib_counts_for(const soil_calib_t *c, uint16_t water_cml) {
+    if (water_cml >= c->water_cml[0]) {
+        return c->counts[0];
+    }
+    for (uint32_t i = 1; i < c->count; i++) {
+        if (water_cml >= c->water_cml[i]) {
+            return lerp(water_cml, c->water_cml[i - 1], c->water_cml[i], c->counts[i - 1], c->counts[i]);
+        }
+    }
+    return c->counts[c->count - 1];
+}
+
+uint16_t soil_calib_max_water(const soil_calib_t *c) {
+    return c->water_cml[0];
+}
+
+bool soil_calib_valid(const soil_calib_t *c) {
+    if (c->count < 2 || c->count > SOIL_CALIB_MAX_POINTS) {
+        return false;
+    }
+    for (uint32_t i = 1; i < c->count; i++) {
+        if (c->counts[i] <= c->counts[i - 1] || c->water_cml[i] >= c->water_cml[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool soil_calib_parse_cml(const char *text, uint16_t *out) {
+    uint32_t whole = 0, frac = 0, frac_digits = 0;
+    bool digits = false, point = false;
+    for (const char *p = text; *p; p++) {
+        if (*p >= '0' && *p <= '9') {
+            digits = true;
+            if (!point) {
+                whole = whole * 10 + (uint32_t)(*p - '0');
+                if (whole > 655) return false;
+            } else if (frac_digits < 2) {
+                frac = frac * 10 + (uint32_t)(*p - '0');
+                frac_digits++;
+            }
+        } else if ((*p == '.' || *p == ',') && !point) {
+            point = true;
+        } else if (*p != ' ') {
+            return false;
+        }
+    }
+    while (frac_digits < 2) {
+        frac *= 10;
+        frac_digits++;
+    }
+    uint32_t cml = whole * 100 + frac;
+    if (!digits || cml > 65535u) {
+        return false;
+    }
+    *out = (uint16_t)cml;
+    return true;
+}
+
+// ===== PERSISTÊNCIA =====
+static uint16_t store_crc(const calib_store_t *st) {
+    return telemetry_crc16((const uint8_t *)st + CALIB_CRC_START, sizeof(*st) - CALIB_CRC_START);
+}
+
+bool soil_calib_load(soil_calib_t *tables, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        tables[i] = soil_calib_default;
+    }
+    if (flash_store_size() == 0) {
+        return false;
+    }
+    const calib_store_t *st = (const calib_store_t *)flash_store_read(FLASH_STORE_CALIB_OFFSET);
+    if (st->magic != CALIB_MAGIC || st->points != SOIL_CALIB_MAX_POINTS || st->crc != store_crc(st)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count && i < st->sensors; i++) {
+        if (soil_calib_valid(&st->tables[i])) {
+            tables[i] = st->tables[i];
+        }
+    }
+    return true;
+}
+
+bool soil_calib_save(const soil_calib_t *tables, uint32_t count) {
+    if (flash_store_size() == 0 || count > SOIL_CALIB_MAX_SENSORS) {
+        return false;
+    }
+    // Imagem do setor em páginas inteiras (resto apagado)
+    static union {
+        calib_store_t st;
+        uint8_t bytes[(sizeof(calib_store_t) + FLASH_STORE_PAGE_SIZE - 1) /
+                      FLASH_STORE_PAGE_SIZE * FLASH_STORE_PAGE_SIZE];
+    } img;
+    memset(&img, 0xFF, sizeof(img));
+    img.st.magic = CALIB_MAGIC;
+    img.st.sensors = (uint8_t)count;
+    img.st.points = SOIL_CALIB_MAX_POINTS;
+    img.st.reserved = 0;
+    memcpy(img.st.tables, tables, count * sizeof(soil_calib_t));
+    img.st.crc = store_crc(&img.st);
+
+    if (!flash_store_erase(FLASH_STORE_CALIB_OFFSET)) {
+        return false;
+    }
+    for (uint32_t off = 0; off < sizeof(img); off += FLASH_STORE_PAGE_SIZE) {
+        if (!flash_store_program(FLASH_STORE_CALIB_OFFSET + off, &img.bytes[off])) {
+            return false;
+        }
+    }
+    return memcmp(flash_store_read(FLASH_STORE_CALIB_OFFSET), img.bytes, sizeof(img)) == 0;
+}
+
+// ===== CALIBRAÇÃO GUIADA =====
+void soil_calib_session_begin(soil_calib_session_t *s, uint8_t zone) {
+    memset(s, 0, sizeof(*s));
+    s->zone = zone;
+}
+
+bool soil_calib_session_measure(soil_calib_session_t *s, uint16_t water_cml, uint64_t now_us) {
+    if (s->count >= SOIL_CALIB_MAX_POINTS) {
+        return false;
+    }
+    s->measuring = true;
+    s->pending_cml = water_cml;
+    s->until_us = now_us + SOIL_CALIB_WINDOW_MS * 1000ull;
+    s->sum = 0;
+    s->samples = 0;
+    return true;
+}
+
+bool soil_calib_session_sample(soil_calib_session_t *s, uint16_t counts, uint64_t now_us) {
+    if (!s->measuring) {
+        return false;
+    }
+    s->sum += counts;
+    s->samples++;
+    if (now_us < s->until_us) {
+        return false;
+    }
+    s->counts[s->count] = (uint16_t)(s->sum / s->samples);
+    s->water_cml[s->count] = s->pending_cml;
+    s->count++;
+    s->measuring = false;
+    return true;
+}
+
+bool soil_calib_session_finish(const soil_calib_session_t *s, soil_calib_t *out) {
+    // Ordem de inserção pelas contagens (poucos pontos)
+    soil_calib_t t = {.count = s->count};
+    for (uint32_t i = 0; i < s->count; i++) {
+        uint32_t j = i;
+        while (j > 0 && t.counts[j - 1] > s->counts[i]) {
+            t.counts[j] = t.counts[j - 1];
+            t.water_cml[j] = t.water_cml[j - 1];
+            j--;
+        }
+        t.counts[j] = s->counts[i];
+        t.water_cml[j] = s->water_cml[i];
+    }
+    if (!soil_calib_valid(&t)) {
+        return false;
+    }
+    *out = t;
+    return true;
+}
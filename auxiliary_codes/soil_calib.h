@@ -0,0 +1,93 @@
+#ifndef SOIL_CALIB_H
+#define SOIL_CALIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Calibração dos sensores de umidade: tabela linear por partes de
+// contagens do ADC → água, toda em inteiros (o M0+ não tem FPU).
+//
+// - Contagens: leitura sobreamostrada normalizada para 16 bits
+//   (0..65535 = 0..3.3 V, mesma escala do histórico)
+// - Água: centésimos de mL no copo de referência (1200 = 12.00 mL)
+// - Os limiares do controle são convertidos para contagens uma vez, ao
+//   carregar a tabela; o laço de controle só compara inteiros
+// - As tabelas ficam no último setor da região da flash (flash_store.h)
+
+#define SOIL_CALIB_MAX_POINTS 8
+#define SOIL_CALIB_MAX_SENSORS 16
+#define SOIL_CALIB_FULL_SCALE_MV 3300
+#define SOIL_CALIB_WINDOW_MS 3000           // Média de cada ponto da calibração guiada
+
+// Tensão → contagens em tempo de compilação (tabelas e constantes)
+#define SOIL_CALIB_COUNTS_FROM_VOLTS(v) ((uint16_t)((v) * 65535.0 / 3.3 + 0.5))
+
+typedef struct __attribute__((packed)) {
+    uint8_t count;                          // Pontos usados (2..SOIL_CALIB_MAX_POINTS)
+    uint8_t reserved;
+    uint16_t counts[SOIL_CALIB_MAX_POINTS]; // Crescente: mais contagens = mais seco
+    uint16_t water_cml[SOIL_CALIB_MAX_POINTS];  // Decrescente
+} soil_calib_t;
+
+// Curva medida no README (0 mL = 3.11 V ... 21 mL = 0.54 V)
+extern const soil_calib_t soil_calib_default;
+
+// Leitura sobreamostrada de 'bits' bits → contagens de 16 bits
+static inline uint16_t soil_calib_counts(uint32_t value, uint8_t bits) {
+    return bits >= 16 ? (uint16_t)(value >> (bits - 16)) : (uint16_t)(value << (16 - bits));
+}
+
+static inline uint32_t soil_calib_counts_to_mv(uint16_t counts) {
+    return (uint32_t)counts * SOIL_CALIB_FULL_SCALE_MV / 65535u;
+}
+
+// Interpolação na tabela, saturando nas pontas
+uint16_t soil_calib_water(const soil_calib_t *calib, uint16_t counts);
+uint16_t soil_calib_counts_for(const soil_calib_t *calib, uint16_t water_cml);
+
+// Água do ponto mais úmido (fundo de escala das barras do OLED)
+uint16_t soil_calib_max_water(const soil_calib_t *calib);
+
+// Contagens e água estritamente monótonas, 2 pontos ou mais
+bool soil_calib_valid(const soil_calib_t *calib);
+
+// "12", "12.5" ou "12,75" → centésimos de mL; false = não é um número
+bool soil_calib_parse_cml(const char *text, uint16_t *out);
+
+// --- Persistência (flash_store) ---
+// Carrega 'count' tabelas; as ausentes ou inválidas ficam com a padrão.
+// false = nada gravado ainda.
+bool soil_calib_load(soil_calib_t *tables, uint32_t count);
+
+// Apaga o setor e grava todas as tabelas. Pausa o outro núcleo como o
+// histórico: quem chama só grava com as bombas desligadas.
+bool soil_calib_save(const soil_calib_t *tables, uint32_t count);
+
+// --- Calibração guiada ---
+// Para cada ponto, o usuário prepara o vaso com uma quantidade conhecida de
+// água e informa o valor; a sessão faz a média das leituras da zona por
+// SOIL_CALIB_WINDOW_MS e guarda o par (contagens, água).
+typedef struct {
+    uint8_t zone;
+    uint8_t count;
+    uint16_t counts[SOIL_CALIB_MAX_POINTS];
+    uint16_t water_cml[SOIL_CALIB_MAX_POINTS];
+    bool measuring;
+    uint16_t pending_cml;
+    uint64_t until_us;
+    uint64_t sum;
+    uint32_t samples;
+} soil_calib_session_t;
+
+void soil_calib_session_begin(soil_calib_session_t *s, uint8_t zone);
+
+// Começa a medir um ponto; false = tabela cheia
+bool soil_calib_session_measure(soil_calib_session_t *s, uint16_t water_cml, uint64_t now_us);
+
+// Leitura da zona em calibração; true = ponto concluído (s->count cresceu)
+bool soil_calib_session_sample(soil_calib_session_t *s, uint16_t counts, uint64_t now_us);
+
+// Ordena e valida os pontos; false = pontos insuficientes ou não monótonos
+bool soil_calib_session_finish(const soil_calib_session_t *s, soil_calib_t *out);
+
+#endif // SOIL_CALIB_H
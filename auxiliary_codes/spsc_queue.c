@@ -0,0 +1,49 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "spsc_queue.h"                     // Fila produtor/consumidor sem trava
+#include "pico/stdlib.h"                    // __dmb (barreira de memória entre núcleos)
+#include <string.h>
+
+void spsc_queue_init(spsc_queue_t *q, void *storage, uint32_t elem_size, uint32_t capacity) {
+    q->storage = storage;
+    q->elem_size = elem_size;
+    q->capacity = capacity;
+    q->head = 0;
+    q->tail = 0;
+    q->dropped = 0;
+    q->max_depth = 0;
+}
+
+bool spsc_queue_push(spsc_queue_t *q, const void *elem) {
+    uint32_t head = q->head;
+    uint32_t depth = head - q->tail;
+    if (depth >= q->capacity) {
+        q->dropped++;
+        return false;
+    }
+
+    memcpy(&q->storage[(head & (q->capacity - 1)) * q->elem_size], elem, q->elem_size);
+    __dmb();                                // Dados visíveis antes do novo índice
+    q->head = head + 1;
+
+    if (depth + 1 > q->max_depth) {
+        q->max_depth = depth + 1;
+    }
+    return true;
+}
+
+bool spsc_queue_pop(spsc_queue_t *q, void *elem) {
+    uint32_t tail = q->tail;
+    if (tail == q->head) {
+        return false;
+    }
+
+    __dmb();                                // Lê o elemento só depois de ver o índice
+    memcpy(elem, &q->storage[(tail & (q->capacity - 1)) * q->elem_size], q->elem_size);
+    __dmb();
+    q->tail = tail + 1;
+    return true;
+}
+
+uint32_t spsc_queue_depth(const spsc_queue_t *q) {
+    return q->head - q->tail;
+}
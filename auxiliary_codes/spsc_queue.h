@@ -0,0 +1,25 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Fila sem trava para um produtor e um consumidor (ex.: core0 → core1).
+// Cada índice é escrito por um único lado; elementos de tamanho fixo.
+typedef struct {
+    uint8_t *storage;             // capacity * elem_size bytes
+    uint32_t elem_size;
+    uint32_t capacity;            // Potência de 2
+    volatile uint32_t head;       // Escrito apenas pelo produtor
+    volatile uint32_t tail;       // Escrito apenas pelo consumidor
+    volatile uint32_t dropped;    // Pushes recusados por fila cheia (produtor)
+    volatile uint32_t max_depth;  // Maior ocupação observada (produtor)
+} spsc_queue_t;
+
+void spsc_queue_init(spsc_queue_t *q, void *storage, uint32_t elem_size, uint32_t capacity);
+bool spsc_queue_push(spsc_queue_t *q, const void *elem);   // Nunca bloqueia
+bool spsc_queue_pop(spsc_queue_t *q, void *elem);
+uint32_t spsc_queue_depth(const spsc_queue_t *q);
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,120 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "status_display.h"                 // Segundo display
+#include "oled_panel.hpp"                   // Painel especializado em tempo de compilação
+#include "oled_panel_pico.hpp"              // I2C do RP2040
+
+extern "C" {
+#include "oled_font.h"                      // Mesma fonte do display principal
+#include "text_fmt.h"                       // Números sem printf
+#include "irrigation_fsm.h"                 // Nome dos estados
+}
+
+// ===== Painel =====
+// Troque estas linhas para outro painel: o buffer e a inicialização
+// acompanham o tipo (ex.: Geometry128x64 com Controller::SH1106)
+#define STATUS_DISPLAY_SDA_GPIO 8           // GPIO 8 - SDA do i2c0
+#define STATUS_DISPLAY_SCL_GPIO 9           // GPIO 9 - SCL do i2c0
+#define STATUS_DISPLAY_BAUDRATE 400000
+
+using StatusBus = oled::PicoI2c<0, STATUS_DISPLAY_SDA_GPIO, STATUS_DISPLAY_SCL_GPIO>;
+using StatusPanel = oled::Panel<oled::Geometry128x32, oled::Controller::SSD1306, StatusBus, 0x3C>;
+
+static_assert(sizeof(StatusPanel) < StatusPanel::geometry::buffer_size + 64,
+              "RAM do painel: o buffer e pouco mais");
+
+#define MAX_ZONES 16
+#define LINE_CHARS 21                       // 128 colunas / 6
+
+struct zone_line_t {
+    uint16_t water_cml;
+    uint16_t full_cml;
+    uint8_t state;
+    bool has_reading;
+};
+
+static StatusPanel painel;
+static zone_line_t zones[MAX_ZONES];
+static uint32_t zone_count;
+static uint32_t first_zone;                 // Primeira zona do grupo mostrado
+static uint64_t next_update_us;
+static uint64_t next_page_us;
+static char shown[StatusPanel::geometry::pages][LINE_CHARS + 1];
+
+bool status_display_init(uint32_t count) {
+    zone_count = count > MAX_ZONES ? MAX_ZONES : count;
+    StatusBus::init(STATUS_DISPLAY_BAUDRATE);
+    bool ok = painel.init();
+    painel.clear();
+    return ok;
+}
+
+void status_display_set(uint32_t zone, uint16_t water_cml, uint16_t full_cml, uint8_t state) {
+    if (zone >= zone_count) {
+        return;
+    }
+    zones[zone] = zone_line_t{water_cml, full_cml, state, true};
+}
+
+// "z3  61% ocioso"
+static void format_line(uint32_t zone, char *line) {
+    const zone_line_t &z = zones[zone];
+    uint32_t n = 0;
+    line[n++] = 'z';
+    n += text_fmt_u32_pad(&line[n], zone, 2, ' ');
+    line[n++] = ' ';
+    if (z.has_reading && z.full_cml) {
+        uint32_t pct = (uint32_t)z.water_cml * 100u / z.full_cml;
+        n += text_fmt_u32_pad(&line[n], pct > 100 ? 100 : pct, 3, ' ');
+        line[n++] = '%';
+        line[n++] = ' ';
+        const char *estado = irrigation_state_name((irrigation_state_t)z.state);
+        while (*estado && n < LINE_CHARS) {
+            line[n++] = *estado++;
+        }
+    } else {
+        line[n++] = ' ';
+        line[n++] = '-';
+        line[n++] = '-';
+    }
+    while (n < LINE_CHARS) {
+        line[n++] = ' ';                    // Apaga o resto da linha anterior
+    }
+    line[n] = '\0';
+}
+
+bool status_display_power(bool on) {
+    return painel.set_display_on(on);
+}
+
+bool status_display_update(uint64_t now_us) {
+    if (zone_count == 0 || now_us < next_update_us) {
+        return false;
+    }
+    next_update_us = now_us + STATUS_DISPLAY_PERIOD_MS * 1000ull;
+    constexpr uint32_t lines = StatusPanel::geometry::pages;
+    if (zone_count > lines && now_us >= next_page_us) {
+        if (next_page_us) {
+            first_zone = first_zone + lines < zone_count ? first_zone + lines : 0;
+        }
+        next_page_us = now_us + STATUS_DISPLAY_PAGE_MS * 1000ull;
+    }
+
+    // Uma linha por página; só os caracteres que mudaram
+    for (uint32_t i = 0; i < lines; i++) {
+        char line[LINE_CHARS + 12];
+        if (first_zone + i < zone_count) {
+            format_line(first_zone + i, line);
+        } else {
+            for (uint32_t k = 0; k < LINE_CHARS; k++) line[k] = ' ';
+            line[LINE_CHARS] = '\0';
+        }
+        int adv = oled_text_advance(&oled_font_5x7);
+        for (uint32_t k = 0; k < LINE_CHARS; k++) {
+            if (shown[i][k] != line[k]) {
+                painel.draw_char(oled_font_5x7, (int)k * adv, (int)i * 8, line[k], true);
+                shown[i][k] = line[k];
+            }
+        }
+    }
+    return painel.update();
+}
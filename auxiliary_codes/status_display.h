@@ -0,0 +1,34 @@
+#ifndef STATUS_DISPLAY_H
+#define STATUS_DISPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Segundo display, opcional (-DPICO_PLANT_STATUS_DISPLAY=ON): uma linha por
+// zona com umidade e estado, num painel pequeno no i2c0. O tipo do painel
+// (geometria, controlador, pinos e endereço) é escolhido em
+// status_display.cpp e especializado em tempo de compilação (oled_panel.hpp).
+
+#define STATUS_DISPLAY_PERIOD_MS 500    // Atualização bloqueante: no máximo 2 vezes por segundo
+#define STATUS_DISPLAY_PAGE_MS 3000     // Mais zonas que linhas: alterna o grupo mostrado
+
+bool status_display_init(uint32_t zone_count);     // false = painel não respondeu
+
+// Dados de uma zona (desenha só em status_display_update)
+void status_display_set(uint32_t zone, uint16_t water_cml, uint16_t full_cml, uint8_t state);
+
+// Liga/desliga o painel (modo de baixo consumo, junto com o principal)
+bool status_display_power(bool on);
+
+// Redesenha e envia o que mudou (bloqueante); false = painel sem ACK
+bool status_display_update(uint64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATUS_DISPLAY_H
@@ -0,0 +1,150 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "task_sched.h"                     // Tarefas periódicas
+#include "hal.h"                            // Relógio e espera pelo alarme
+#include <stdio.h>                          // Tabela em texto
+#include <string.h>
+
+void task_sched_init(task_sched_t *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+int task_sched_add(task_sched_t *s, const char *name, task_sched_fn_t fn, void *ctx,
+                   uint32_t period_us, uint8_t priority, uint64_t first_us) {
+    if (s->count >= TASK_SCHED_MAX_TASKS || period_us == 0) {
+        return -1;
+    }
+    task_sched_task_t *t = &s->tasks[s->count];
+    memset(t, 0, sizeof(*t));
+    t->name = name;
+    t->fn = fn;
+    t->ctx = ctx;
+    t->period_us = period_us;
+    t->deadline_us = period_us;
+    t->priority = priority;
+    t->enabled = true;
+    t->release_us = first_us;
+    return (int)s->count++;
+}
+
+void task_sched_set_deadline(task_sched_t *s, int id, uint32_t deadline_us) {
+    task_sched_task_t *t = &s->tasks[id];
+    t->deadline_us = deadline_us && deadline_us < t->period_us ? deadline_us : t->period_us;
+}
+
+void task_sched_set_period(task_sched_t *s, int id, uint32_t period_us, uint64_t now_us) {
+    task_sched_task_t *t = &s->tasks[id];
+    if (period_us == 0 || period_us == t->period_us) {
+        return;
+    }
+    bool prazo_curto = t->deadline_us < t->period_us;
+    t->period_us = period_us;
+    if (!prazo_curto || t->deadline_us > period_us) {
+        t->deadline_us = period_us;
+    }
+    t->release_us = now_us + period_us;
+}
+
+void task_sched_set_enabled(task_sched_t *s, int id, bool enabled, uint64_t now_us) {
+    task_sched_task_t *t = &s->tasks[id];
+    if (enabled && !t->enabled) {
+        t->release_us = now_us;
+    }
+    t->enabled = enabled;
+}
+
+void task_sched_trigger(task_sched_t *s, int id, uint64_t now_us) {
+    task_sched_task_t *t = &s->tasks[id];
+    if (t->enabled && t->release_us > now_us) {
+        t->release_us = now_us;
+    }
+}
+
+void task_sched_resync(task_sched_t *s, uint64_t now_us) {
+    for (uint32_t i = 0; i < s->count; i++) {
+        s->tasks[i].release_us = now_us;
+    }
+}
+
+// Pronta de maior prioridade; empate: liberação mais antiga
+static task_sched_task_t *next_ready(task_sched_t *s, uint64_t now_us) {
+    task_sched_task_t *best = NULL;
+    for (uint32_t i = 0; i < s->count; i++) {
+        task_sched_task_t *t = &s->tasks[i];
+        if (!t->enabled || t->release_us > now_us) {
+            continue;
+        }
+        if (!best || t->priority < best->priority ||
+            (t->priority == best->priority && t->release_us < best->release_us)) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+bool task_sched_run_ready(task_sched_t *s) {
+    uint64_t inicio = hal_time_us();
+    task_sched_task_t *t = next_ready(s, inicio);
+    if (!t) {
+        return false;
+    }
+
+    uint64_t liberacao = t->release_us;
+    uint32_t atraso = (uint32_t)(inicio - liberacao);
+    if (atraso > t->late_max_us) {
+        t->late_max_us = atraso;
+    }
+    t->fn(t->ctx, liberacao, inicio);
+    uint64_t fim = hal_time_us();
+    uint32_t execucao = (uint32_t)(fim - inicio);
+    if (execucao > t->exec_max_us) {
+        t->exec_max_us = execucao;
+    }
+    t->runs++;
+    if (fim > liberacao + t->deadline_us) {
+        t->misses++;
+    }
+
+    // Próxima liberação na mesma fase. Se a seguinte também já chegou, as
+    // anteriores a ela são puladas: a tarefa roda uma vez, não em rajada.
+    // set_period/trigger dentro da própria tarefa já escolheram a próxima.
+    if (t->release_us == liberacao) {
+        t->release_us += t->period_us;
+        if (t->release_us + t->period_us <= fim) {
+            uint64_t puladas = (fim - t->release_us) / t->period_us;
+            t->release_us += puladas * t->period_us;
+            t->overruns += (uint32_t)puladas;
+        }
+    }
+    return true;
+}
+
+uint64_t task_sched_next_release(const task_sched_t *s) {
+    uint64_t proxima = UINT64_MAX;
+    for (uint32_t i = 0; i < s->count; i++) {
+        const task_sched_task_t *t = &s->tasks[i];
+        if (t->enabled && t->release_us < proxima) {
+            proxima = t->release_us;
+        }
+    }
+    return proxima;
+}
+
+void task_sched_poll(task_sched_t *s) {
+    if (task_sched_run_ready(s)) {
+        return;
+    }
+    hal_wait_until_us(task_sched_next_release(s));
+}
+
+void task_sched_print(const task_sched_t *s, const char *title) {
+    printf("%s: tarefas (us)\n", title);
+    printf("tarefa      período  prio  execuções  atraso máx  exec máx  perdas  puladas\n");
+    for (uint32_t i = 0; i < s->count; i++) {
+        const task_sched_task_t *t = &s->tasks[i];
+        printf("%-10s %9lu %5u %10lu %11lu %9lu %7lu %8lu%s\n", t->name,
+               (unsigned long)t->period_us, t->priority, (unsigned long)t->runs,
+               (unsigned long)t->late_max_us, (unsigned long)t->exec_max_us,
+               (unsigned long)t->misses, (unsigned long)t->overruns,
+               t->enabled ? "" : " (desligada)");
+    }
+}
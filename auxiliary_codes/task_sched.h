@@ -0,0 +1,84 @@
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Escalonador de tarefas periódicas de um núcleo (cooperativo, sem
+// preempção). Cada tarefa tem período e prioridade próprios; as liberações
+// são prazos absolutos (fase + n × período), então o atraso de uma volta
+// não se acumula nas seguintes. Entre liberações o núcleo espera um alarme
+// de hardware (hal_wait_until_us).
+//
+// Contadores por tarefa:
+// - atraso: início − liberação (jitter)
+// - perda de prazo: terminou depois de liberação + prazo (padrão: o período)
+// - sobrecarga: liberações puladas porque a tarefa ainda não tinha rodado a
+//   anterior; não há rajada para recuperar, a fase é mantida
+//
+// Um único núcleo chama as funções de um escalonador; os contadores podem
+// ser lidos do outro núcleo sem trava (valores de 32 bits).
+
+#define TASK_SCHED_MAX_TASKS 8
+
+// Corpo da tarefa: 'release_us' é a liberação atendida, 'now_us' o início
+typedef void (*task_sched_fn_t)(void *ctx, uint64_t release_us, uint64_t now_us);
+
+typedef struct {
+    const char *name;
+    task_sched_fn_t fn;
+    void *ctx;
+    uint32_t period_us;
+    uint32_t deadline_us;       // Relativo à liberação
+    uint8_t priority;           // 0 = mais alta; empate: liberação mais antiga
+    bool enabled;
+    uint64_t release_us;        // Próxima liberação absoluta
+    // --- Contadores ---
+    uint32_t runs;
+    uint32_t overruns;          // Liberações puladas
+    uint32_t misses;            // Execuções terminadas depois do prazo
+    uint32_t late_max_us;       // Maior atraso do início
+    uint32_t exec_max_us;       // Maior tempo de execução
+} task_sched_task_t;
+
+typedef struct {
+    task_sched_task_t tasks[TASK_SCHED_MAX_TASKS];
+    uint32_t count;
+} task_sched_t;
+
+void task_sched_init(task_sched_t *s);
+
+// Primeira liberação em 'first_us'; retorna o índice (-1 = tabela cheia)
+int task_sched_add(task_sched_t *s, const char *name, task_sched_fn_t fn, void *ctx,
+                   uint32_t period_us, uint8_t priority, uint64_t first_us);
+
+// Prazo menor que o período (padrão: o próprio período)
+void task_sched_set_deadline(task_sched_t *s, int id, uint32_t deadline_us);
+
+// Novo período a partir de 'now_us' (nova fase, sem contar perdas)
+void task_sched_set_period(task_sched_t *s, int id, uint32_t period_us, uint64_t now_us);
+
+// Desligada, a tarefa não é liberada; religada, volta com fase em 'now_us'
+void task_sched_set_enabled(task_sched_t *s, int id, bool enabled, uint64_t now_us);
+
+// Liberação imediata fora do período (evento); a fase passa a contar daqui
+void task_sched_trigger(task_sched_t *s, int id, uint64_t now_us);
+
+// Todas as tarefas com fase em 'now_us' (depois de uma pausa planejada,
+// como o sono do modo de baixo consumo: não conta como atraso)
+void task_sched_resync(task_sched_t *s, uint64_t now_us);
+
+// Roda a tarefa pronta de maior prioridade; false = nenhuma pronta
+bool task_sched_run_ready(task_sched_t *s);
+
+// Próxima liberação entre as tarefas ligadas (UINT64_MAX = nenhuma)
+uint64_t task_sched_next_release(const task_sched_t *s);
+
+// Roda a pronta de maior prioridade; sem nenhuma, espera o alarme da próxima liberação (ou um
+// evento do outro núcleo) e retorna, para quem chama checar o próprio estado
+void task_sched_poll(task_sched_t *s);
+
+// Tabela em texto (printf) com os contadores de cada tarefa
+void task_sched_print(const task_sched_t *s, const char *title);
+
+#endif // TASK_SCHED_H
@@ -0,0 +1,81 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "telemetry.h"                      // Fila de quadros de telemetria
+#include "pico/stdio.h"                     // Saída pelo driver do stdio (único dono da USB)
+#include "pico/stdio_usb.h"                 // Estado da conexão
+#include "pico/time.h"                      // Instante dos quadros de texto
+#include <stdarg.h>
+#include <stdio.h>                          // vsnprintf
+#include <string.h>
+
+// ===== BUFFER DE TRANSMISSÃO =====
+// Produtor e consumidor no mesmo núcleo (core1): basta um anel simples
+static uint8_t tx_buf[TELEMETRY_TX_BUFFER];
+static uint32_t tx_head;                    // Próximo byte a escrever
+static uint32_t tx_tail;                    // Próximo byte a enviar
+static uint32_t dropped;
+static uint8_t seq;
+
+bool telemetry_send(void *record, size_t len) {
+    telemetry_header_t *hdr = record;
+    hdr->seq = seq++;
+
+    static uint8_t frame[TELEMETRY_MAX_FRAME];  // Páginas do histórico: fora da pilha do core1
+    size_t n = telemetry_encode_frame(record, len, frame);
+    if (TELEMETRY_TX_BUFFER - (tx_head - tx_tail) < n) {
+        dropped++;                          // Host não está lendo: perde o quadro inteiro
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        tx_buf[(tx_head + i) & (TELEMETRY_TX_BUFFER - 1)] = frame[i];
+    }
+    tx_head += n;
+    return true;
+}
+
+bool telemetry_text(const char *fmt, ...) {
+    static telemetry_text_t linha;          // Fora da pilha do core1
+    linha.hdr = (telemetry_header_t){TELEMETRY_TEXT, 0, time_us_32()};
+
+    char buf[TELEMETRY_TEXT_LEN + 1];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    if (n < 0) {
+        return false;
+    }
+    size_t len = (size_t)n < TELEMETRY_TEXT_LEN ? (size_t)n : TELEMETRY_TEXT_LEN;
+    if (len > 0 && buf[len - 1] == '\n') {
+        len--;                              // Cada quadro já é uma linha
+    }
+    memcpy(linha.text, buf, len);
+    return telemetry_send(&linha, offsetof(telemetry_text_t, text) + len);
+}
+
+void telemetry_poll(void) {
+    if (!stdio_usb_connected()) {
+        return;
+    }
+    // Bytes crus (sem CRLF) sob a trava do stdio; o driver escreve no FIFO
+    // sob a própria trava e faz o flush. O stdio da UART fica desligado no
+    // build com telemetria (CMakeLists.txt): a USB é o único destino. Bytes perdidos num tempo esgotado
+    // só corrompem um quadro: o decodificador ressincroniza no próximo 0x00.
+    uint32_t entregues = 0;
+    while (tx_head != tx_tail && entregues < TELEMETRY_POLL_BYTES) {
+        uint32_t start = tx_tail & (TELEMETRY_TX_BUFFER - 1);
+        uint32_t chunk = tx_head - tx_tail;
+        if (chunk > TELEMETRY_TX_BUFFER - start) chunk = TELEMETRY_TX_BUFFER - start;
+        if (chunk > TELEMETRY_POLL_BYTES - entregues) chunk = TELEMETRY_POLL_BYTES - entregues;
+        stdio_put_string((const char *)&tx_buf[start], (int)chunk, false, false);
+        tx_tail += chunk;
+        entregues += chunk;
+    }
+}
+
+uint32_t telemetry_dropped(void) {
+    return dropped;
+}
+
+size_t telemetry_free(void) {
+    return TELEMETRY_TX_BUFFER - (tx_head - tx_tail);
+}
@@ -0,0 +1,40 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "telemetry_frame.h"
+
+// Telemetria binária pela USB CDC (substitui os relatórios em texto).
+// Pode ser desligada pelo CMake (-DPICO_PLANT_TELEMETRY=OFF)
+//
+// A USB tem um dono só: o driver stdio_usb do SDK, que roda o TinyUSB no
+// próprio IRQ. Os quadros saem por ele (sob a trava do stdio, sem tradução
+// CRLF) e, com a telemetria ligada, nenhum texto vai pelo printf: o que
+// precisa chegar ao usuário vira quadro TELEMETRY_TEXT (telemetry_text).
+#ifndef PICO_PLANT_TELEMETRY
+#define PICO_PLANT_TELEMETRY 1
+#endif
+
+#define TELEMETRY_TX_BUFFER 4096    // Potência de 2: ~150 ms de amostras a 100 Hz sem host lendo
+#define TELEMETRY_POLL_BYTES 1024   // Máximo entregue ao driver por telemetry_poll
+
+// Codifica e enfileira um registro (cabeçalho já com tipo e instante).
+// Nunca bloqueia: buffer cheio descarta o quadro inteiro.
+bool telemetry_send(void *record, size_t len);
+
+// Linha de texto num quadro (printf sem o '\n' final; cortada em TELEMETRY_TEXT_LEN)
+bool telemetry_text(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Entrega até TELEMETRY_POLL_BYTES ao driver da USB (chamar no laço do core1).
+// Com o FIFO cheio o driver espera o host, no máximo
+// PICO_STDIO_USB_STDOUT_TIMEOUT_US (reduzido pelo CMake) se ele parou de ler.
+void telemetry_poll(void);
+
+uint32_t telemetry_dropped(void);
+
+// Bytes livres no buffer (envios em rajada esperam caber um quadro inteiro)
+size_t telemetry_free(void);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,102 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "telemetry_frame.h"                // Formato dos quadros de telemetria
+#include <string.h>
+
+// CRC bit a bit: ~30 bytes por registro, não compensa uma tabela na flash
+uint16_t telemetry_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// COBS: cada 0x00 vira a distância até o próximo zero, então 0x00 só
+// aparece como delimitador e o host ressincroniza no próximo quadro
+static size_t cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t code_pos = 0;
+    size_t o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            if (++code == 0xFF) {
+                out[code_pos] = code;
+                code_pos = o++;
+                code = 1;
+            }
+        }
+    }
+    out[code_pos] = code;
+    return o;
+}
+
+static bool cobs_decode(const uint8_t *in, size_t len, uint8_t *out, size_t out_max, size_t *out_len) {
+    size_t i = 0, o = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) {
+            return false;
+        }
+        for (uint8_t k = 1; k < code; k++) {
+            if (o >= out_max) return false;
+            out[o++] = in[i++];
+        }
+        // Zero implícito, exceto no fim do quadro ou após um bloco cheio
+        if (code != 0xFF && i < len) {
+            if (o >= out_max) return false;
+            out[o++] = 0;
+        }
+    }
+    *out_len = o;
+    return true;
+}
+
+size_t telemetry_encode_frame(const void *record, size_t len, uint8_t *frame) {
+    uint8_t buf[TELEMETRY_MAX_RECORD + 2];
+    memcpy(buf, record, len);
+    uint16_t crc = telemetry_crc16(buf, len);
+    buf[len] = (uint8_t)crc;
+    buf[len + 1] = (uint8_t)(crc >> 8);
+    size_t n = cobs_encode(buf, len + 2, frame);
+    frame[n++] = 0x00;                      // Delimitador
+    return n;
+}
+
+bool telemetry_decode_frame(const uint8_t *frame, size_t len, uint8_t *record, size_t *record_len) {
+    uint8_t buf[TELEMETRY_MAX_RECORD + 2];
+    size_t n;
+    if (!cobs_decode(frame, len, buf, sizeof(buf), &n) || n < 2 + sizeof(telemetry_header_t)) {
+        return false;
+    }
+    uint16_t crc = buf[n - 2] | (uint16_t)buf[n - 1] << 8;
+    if (telemetry_crc16(buf, n - 2) != crc) {
+        return false;
+    }
+    memcpy(record, buf, n - 2);
+    *record_len = n - 2;
+    return true;
+}
+
+size_t telemetry_record_size(uint8_t type) {
+    switch (type) {
+        case TELEMETRY_SAMPLE: return sizeof(telemetry_sample_t);
+        case TELEMETRY_EVENT:  return sizeof(telemetry_event_t);
+        case TELEMETRY_STATUS: return sizeof(telemetry_status_t);
+        case TELEMETRY_BOOT:   return sizeof(telemetry_boot_t);
+        case TELEMETRY_CYCLE:  return sizeof(telemetry_cycle_t);
+        case TELEMETRY_LOG_PAGE: return sizeof(telemetry_log_page_t);
+        case TELEMETRY_DOSE:   return sizeof(telemetry_dose_t);
+        case TELEMETRY_PROFILE: return sizeof(telemetry_profile_t);
+        case TELEMETRY_TASK:   return sizeof(telemetry_task_t);
+        case TELEMETRY_TEXT:   return sizeof(telemetry_text_t);
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "flash_log_format.h"           // Páginas do histórico (despejo)
+
+// Protocolo de telemetria binária (firmware → host).
+// Quadro = COBS(registro + CRC-16) seguido de 0x00. Registros de tamanho
+// fixo por tipo (exceto a página do histórico e o texto), little-endian, sem padding. Portável: usado também pelo
+// decodificador (tools/telemetry_decode.c) e pelo simulador.
+
+#define TELEMETRY_MAX_RECORD (6 + 4 + FLASH_LOG_PAGE_SIZE)   // telemetry_log_page_t
+// COBS acrescenta 1 byte a cada 254; + CRC + delimitador
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_RECORD + 2 + (TELEMETRY_MAX_RECORD + 2) / 254 + 1 + 1)
+
+typedef enum {
+    TELEMETRY_SAMPLE = 1,       // Uma iteração do laço de controle
+    TELEMETRY_EVENT,            // Mudança de estado da irrigação
+    TELEMETRY_STATUS,           // Estatísticas periódicas (1 Hz)
+    TELEMETRY_BOOT,             // Tempos de inicialização
+    TELEMETRY_CYCLE,            // Ciclo de medição do modo de baixo consumo
+    TELEMETRY_LOG_PAGE,         // Página do histórico da flash (despejo)
+    TELEMETRY_DOSE,             // Fim de um ciclo de irrigação (dosagem adaptativa)
+    TELEMETRY_PROFILE,          // Histograma de uma fase (instrumentação, sob pedido)
+    TELEMETRY_TASK,             // Contadores de uma tarefa periódica (sob pedido)
+    TELEMETRY_TEXT,             // Linha de texto (calibração guiada)
+} telemetry_type_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t type;               // telemetry_type_t
+    uint8_t seq;                // Sequência (detecta quadros perdidos)
+    uint32_t timestamp_us;      // 32 bits baixos de time_us_64()
+} telemetry_header_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint32_t value;             // Leitura sobreamostrada (filtrada)
+    uint16_t raw;               // Média em 12 bits
+    uint16_t water_cml;         // Água pela calibração do sensor (centésimos de mL)
+    uint8_t bits;               // Resolução de 'value'
+    uint8_t state;              // irrigation_state_t
+    uint8_t pump_on;
+    uint8_t zone;
+    int16_t jitter_us;          // Saturado em ±32767
+    uint16_t loop_us;           // Saturado em 65535
+} telemetry_sample_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint8_t prev_state;
+    uint8_t state;
+    uint8_t reason;             // irrigation_reason_t
+    uint8_t zone;
+    uint32_t pump_off_latency_us;
+    uint16_t wait_ms;           // Espera pela vez no orçamento da fonte (saturado)
+} telemetry_event_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint32_t oled_bytes;        // Último quadro
+    uint32_t oled_us;
+    int16_t jitter_min_us;
+    int16_t jitter_max_us;
+    uint16_t loop_max_us;
+    uint8_t queue_depth;
+    uint8_t queue_peak;
+    uint32_t queue_dropped;
+    uint32_t telemetry_dropped; // Quadros descartados por buffer cheio
+    uint32_t log_pages;         // Páginas do histórico gravadas neste boot
+    uint32_t log_write_us_max;  // Maior pausa para gravar a flash
+} telemetry_status_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint32_t oled_ready_us;
+    uint32_t first_frame_us;
+    uint32_t i2c_hz;
+    uint8_t oled_ok;
+} telemetry_boot_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint32_t interval_ms;
+    uint32_t energy_uj;
+    uint32_t avg_ua;
+} telemetry_cycle_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint8_t zone;
+    uint8_t doses;
+    uint8_t aborted;            // Terminou bloqueado
+    uint16_t start_cml;         // Água (centésimos de mL): início, fim, pico e alvo
+    uint16_t end_cml;
+    uint16_t peak_cml;
+    uint16_t target_cml;
+    uint32_t pump_ms;           // Bomba ligada no ciclo
+    uint32_t settle_ms;         // Início do ciclo → leitura assentada
+    uint16_t gain_cml_s;        // Modelo: centésimos de mL no sensor por s de bomba
+    uint16_t delay_ms;          // Modelo: atraso até a água chegar ao sensor
+} telemetry_dose_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint8_t phase;              // prof_id_t
+    char name[15];              // Nome da fase: o decodificador não depende da tabela
+    uint32_t count;
+    uint32_t min_ns;
+    uint32_t mean_ns;
+    uint32_t p50_ns;            // Limite do balde log2
+    uint32_t p99_ns;
+    uint32_t max_ns;
+    uint32_t overhead_ns;       // Custo de uma medição
+} telemetry_profile_t;
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint8_t core;               // Núcleo do escalonador
+    uint8_t task;               // Índice no escalonador
+    char name[10];
+    uint8_t priority;           // 0 = mais alta
+    uint32_t period_us;
+    uint32_t runs;
+    uint32_t overruns;          // Liberações puladas
+    uint32_t misses;            // Execuções terminadas depois do prazo
+    uint32_t late_max_us;       // Maior atraso do início
+    uint32_t exec_max_us;
+} telemetry_task_t;
+
+// Tamanho variável: só o cabeçalho e os caracteres (sem '\0' nem '\n')
+#define TELEMETRY_TEXT_LEN 120
+
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    char text[TELEMETRY_TEXT_LEN];
+} telemetry_text_t;
+
+// Tamanho variável: só o cabeçalho e a parte usada da página
+typedef struct __attribute__((packed)) {
+    telemetry_header_t hdr;
+    uint16_t index;             // Posição no despejo (ordem cronológica)
+    uint16_t total;             // Posições no despejo
+    uint8_t page[FLASH_LOG_PAGE_SIZE];
+} telemetry_log_page_t;
+
+// CRC-16/CCITT-FALSE (poli 0x1021, inicial 0xFFFF)
+uint16_t telemetry_crc16(const uint8_t *data, size_t len);
+
+// Registro → quadro completo (com 0x00 final); retorna o tamanho
+size_t telemetry_encode_frame(const void *record, size_t len, uint8_t *frame);
+
+// Quadro sem o 0x00 final → registro; false = COBS inválido ou CRC errado
+bool telemetry_decode_frame(const uint8_t *frame, size_t len, uint8_t *record, size_t *record_len);
+
+// Tamanho esperado do registro de cada tipo (0 = tipo desconhecido; para
+// TELEMETRY_LOG_PAGE e TELEMETRY_TEXT, o máximo)
+size_t telemetry_record_size(uint8_t type);
+
+// Saturação para os campos de 16 bits
+static inline int16_t telemetry_sat_i16(int32_t v) {
+    return v > 32767 ? 32767 : v < -32768 ? -32768 : (int16_t)v;
+}
+
+static inline uint16_t telemetry_sat_u16(uint32_t v) {
+    return v > 65535u ? 65535u : (uint16_t)v;
+}
+
+#endif // TELEMETRY_FRAME_H
@@ -0,0 +1,105 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "text_fmt.h"                       // Inteiros para texto
+
+// Pares "00".."99": metade das divisões (o M0+ divide pelo divisor do SIO)
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Dígitos de trás para frente a partir de 'end'; retorna o primeiro
+static char *digits_backwards(char *end, uint32_t v) {
+    while (v >= 100) {
+        const char *pair = &digit_pairs[(v % 100) * 2];
+        v /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    if (v >= 10) {
+        *--end = digit_pairs[v * 2 + 1];
+        *--end = digit_pairs[v * 2];
+    } else {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+static uint32_t copy_out(char *buf, const char *from, const char *end) {
+    uint32_t len = (uint32_t)(end - from);
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = from[i];
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+uint32_t text_fmt_u32(char *buf, uint32_t v) {
+    char tmp[10];
+    char *end = tmp + sizeof(tmp);
+    return copy_out(buf, digits_backwards(end, v), end);
+}
+
+uint32_t text_fmt_u32_pad(char *buf, uint32_t v, uint32_t width, char pad) {
+    char tmp[11];
+    char *end = tmp + sizeof(tmp);
+    char *p = digits_backwards(end, v);
+    while (end - p < (int32_t)width && p > tmp) {
+        *--p = pad;
+    }
+    return copy_out(buf, p, end);
+}
+
+uint32_t text_fmt_fixed(char *buf, uint32_t v, uint32_t decimals) {
+    char tmp[11];
+    char *end = tmp + sizeof(tmp);
+    char *p = digits_backwards(end, v);
+    if (decimals > 9) {
+        decimals = 9;
+    }
+    if (decimals == 0) {
+        return copy_out(buf, p, end);
+    }
+    while (end - p < (int32_t)decimals + 1) {
+        *--p = '0';                         // 5 com 2 casas: "0.05"
+    }
+    // Abre espaço para o ponto deslocando a parte inteira
+    char *dot = end - decimals;
+    for (char *q = p; q < dot; q++) {
+        q[-1] = q[0];
+    }
+    dot[-1] = '.';
+    return copy_out(buf, p - 1, end);
+}
+
+uint32_t text_fmt_duration(char *buf, uint32_t seconds) {
+    uint32_t len;
+    char unit;
+    if (seconds < 60) {
+        len = text_fmt_u32(buf, seconds);
+        unit = 's';
+    } else if (seconds < 3600) {
+        len = text_fmt_u32(buf, seconds / 60);
+        unit = 'm';
+    } else if (seconds < 10 * 3600) {
+        // Horas e minutos enquanto cabem: "3h05"
+        len = text_fmt_u32(buf, seconds / 3600);
+        buf[len++] = 'h';
+        return len + text_fmt_u32_pad(&buf[len], seconds / 60 % 60, 2, '0');
+    } else if (seconds < 100 * 3600) {
+        len = text_fmt_u32(buf, seconds / 3600);
+        unit = 'h';
+    } else {
+        len = text_fmt_u32(buf, seconds / 86400);
+        unit = 'd';
+    }
+    buf[len++] = unit;
+    buf[len] = '\0';
+    return len;
+}
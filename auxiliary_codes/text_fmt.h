@@ -0,0 +1,22 @@
+#ifndef TEXT_FMT_H
+#define TEXT_FMT_H
+
+#include <stdint.h>
+
+// Inteiros para texto sem printf (o OLED redesenha a leitura várias vezes
+// por segundo). Todas escrevem em 'buf' terminado em '\0' e retornam o
+// comprimento; 'buf' precisa de 12 bytes.
+
+// Decimal: "0", "1234"
+uint32_t text_fmt_u32(char *buf, uint32_t v);
+
+// Alinhado à direita em 'width' caracteres, completando com 'pad'
+uint32_t text_fmt_u32_pad(char *buf, uint32_t v, uint32_t width, char pad);
+
+// Ponto fixo: v = 123, 'decimals' = 2 → "1.23" (até 9 casas)
+uint32_t text_fmt_fixed(char *buf, uint32_t v, uint32_t decimals);
+
+// Duração compacta em até 4 caracteres: "45s", "12m", "3h05", "23h", "12d"
+uint32_t text_fmt_duration(char *buf, uint32_t seconds);
+
+#endif // TEXT_FMT_H
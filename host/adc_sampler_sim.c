@@ -0,0 +1,158 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "adc_sampler.h"                    // Mesma API da aquisição por DMA
+#include "adc_sampler_sim.h"                // Entrada do ADC virtual
+#include "hal.h"                            // Relógio virtual
+#include <math.h>
+
+#define MUX_CHANNELS (1u << ADC_SAMPLER_MUX_SELECT_BITS)
+
+// ===== ESTADO DO ADC VIRTUAL =====
+static bool running;
+static adc_sampler_config_t config;
+static uint32_t oversample_log2;
+static uint64_t reading_us;                 // Duração de uma leitura decimada por entrada
+static uint64_t settle_us;                  // Amostras descartadas após trocar o canal do mux
+static uint64_t next_us[ADC_SAMPLER_MAX_INPUTS];  // Fim da próxima leitura de cada entrada
+static uint8_t mux_channel;
+static uint32_t mux_scan;
+static float volts[ADC_SAMPLER_MAX_INPUTS][MUX_CHANNELS + 1];  // Último = entrada direta
+static float noise_lsb = 2.0f;
+static uint32_t rng_state = 1;
+static adc_sampler_stats_t stats;
+
+// xorshift32: reprodutível entre execuções com a mesma semente
+static float uniform(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static float gaussian(void) {
+    float u1 = uniform() + 1e-7f;
+    float u2 = uniform();
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+void adc_sampler_sim_set_voltage(uint32_t input, uint32_t mux, float v) {
+    if (input < ADC_SAMPLER_MAX_INPUTS) {
+        volts[input][mux < MUX_CHANNELS ? mux : MUX_CHANNELS] = v;
+    }
+}
+
+void adc_sampler_sim_set_noise(float lsb, uint32_t seed) {
+    noise_lsb = lsb;
+    rng_state = seed ? seed : 1;
+}
+
+void adc_sampler_init(uint32_t input, uint32_t sample_rate_hz, uint32_t oversample) {
+    const adc_sampler_config_t single = {
+        .input_mask = 1u << input,
+        .mux_input = ADC_SAMPLER_NO_MUX,
+    };
+    adc_sampler_init_config(&single, sample_rate_hz, oversample);
+}
+
+void adc_sampler_init_config(const adc_sampler_config_t *cfg, uint32_t sample_rate_hz,
+                             uint32_t oversample) {
+    if (oversample > ADC_SAMPLER_MAX_OVERSAMPLE) {
+        oversample = ADC_SAMPLER_MAX_OVERSAMPLE;
+    }
+    config = *cfg;
+    oversample_log2 = oversample;
+    uint32_t inputs = (uint32_t)__builtin_popcount(config.input_mask & 7u);
+    if (inputs == 0) {
+        inputs = 1;
+    }
+    // Mesma repartição do round-robin: cada entrada recebe a taxa / entradas;
+    // a troca do mux perde até dois blocos do DMA dessa entrada
+    reading_us = ((uint64_t)1000000u << oversample) * inputs / sample_rate_hz;
+    settle_us = 2ull * ADC_SAMPLER_BLOCK_SAMPLES * 1000000u / sample_rate_hz;
+    mux_channel = 0;
+    for (uint32_t i = 0; i < ADC_SAMPLER_MAX_INPUTS; i++) {
+        next_us[i] = hal_time_us() + reading_us;
+    }
+    running = true;
+}
+
+void adc_sampler_stop(void) {
+    running = false;
+}
+
+void adc_sampler_set_mux_scan(uint32_t channel_mask) {
+    mux_scan = channel_mask;
+}
+
+// Média de 2^n amostras: o ruído cai com a raiz do número de amostras
+static void make_reading(adc_sampler_reading_t *out, uint32_t input, uint64_t timestamp_us) {
+    bool muxed = input == config.mux_input;
+    float v = volts[input][muxed ? mux_channel : MUX_CHANNELS];
+    uint32_t n = 1u << oversample_log2;
+    float mean = v * 4095.0f / 3.3f + gaussian() * noise_lsb / sqrtf((float)n);
+    if (mean < 0) mean = 0;
+    if (mean > 4095.0f) mean = 4095.0f;
+
+    uint32_t sum = (uint32_t)(mean * n + 0.5f);
+    out->value = sum >> (oversample_log2 / 2);
+    out->mean = (uint16_t)(sum >> oversample_log2);
+    out->bits = 12 + oversample_log2 / 2;
+    out->input = (uint8_t)input;
+    out->mux = muxed ? mux_channel : ADC_SAMPLER_NO_MUX;
+    out->timestamp_us = timestamp_us;
+    stats.readings++;
+}
+
+// Próximo canal da varredura, como mux_advance() no firmware
+static void mux_advance(uint32_t input) {
+    uint32_t next = mux_channel;
+    for (uint32_t i = 0; i < config.mux_channels; i++) {
+        next = (next + 1) % config.mux_channels;
+        if (mux_scan == 0 || (mux_scan & (1u << next))) break;
+    }
+    if (next != mux_channel) {
+        mux_channel = (uint8_t)next;
+        next_us[input] += settle_us;
+    }
+}
+
+bool adc_sampler_poll(adc_sampler_reading_t *out) {
+    if (!running) {
+        return false;
+    }
+    // Entrada com a leitura pronta mais antiga (ordem da fila do firmware)
+    int input = -1;
+    for (uint32_t i = 0; i < ADC_SAMPLER_MAX_INPUTS; i++) {
+        if ((config.input_mask & (1u << i)) && next_us[i] <= hal_time_us() &&
+            (input < 0 || next_us[i] < next_us[input])) {
+            input = (int)i;
+        }
+    }
+    if (input < 0) {
+        return false;
+    }
+    // Consumidor atrasado além da fila: as leituras mais novas se perdem
+    uint64_t late = hal_time_us() - next_us[input];
+    if (late >= ADC_SAMPLER_QUEUE_LEN * reading_us) {
+        uint64_t lost = late / reading_us + 1 - ADC_SAMPLER_QUEUE_LEN;
+        stats.dropped_readings += (uint32_t)lost;
+        next_us[input] += lost * reading_us;
+    }
+    make_reading(out, (uint32_t)input, next_us[input]);
+    next_us[input] += reading_us;
+    if ((uint32_t)input == config.mux_input) {
+        mux_advance((uint32_t)input);
+    }
+    return true;
+}
+
+bool adc_sampler_get_latest(adc_sampler_reading_t *out) {
+    bool found = false;
+    while (adc_sampler_poll(out)) {
+        found = true;
+    }
+    return found;
+}
+
+void adc_sampler_get_stats(adc_sampler_stats_t *out) {
+    *out = stats;
+}
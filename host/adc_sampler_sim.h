@@ -0,0 +1,13 @@
+#ifndef ADC_SAMPLER_SIM_H
+#define ADC_SAMPLER_SIM_H
+
+#include <stdint.h>
+
+// Entradas analógicas do ADC virtual (implementa adc_sampler.h).
+// Cada leitura decimada usa a tensão vigente no fim do bloco, com ruído
+// gaussiano de 'noise_lsb' por amostra de 12 bits (reduzido pela média).
+// 'mux' = canal do multiplexador na entrada (ADC_SAMPLER_NO_MUX = direta).
+void adc_sampler_sim_set_voltage(uint32_t input, uint32_t mux, float volts);
+void adc_sampler_sim_set_noise(float noise_lsb, uint32_t seed);
+
+#endif // ADC_SAMPLER_SIM_H
@@ -0,0 +1,172 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include <stdio.h>                          // Entrada e saída padrão
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>                           // Só a referência e a geometria ideal
+#include "oled_ssd1306.h"                   // Arco inteiro do driver
+#include "ssd1306_sim.h"                    // GDDRAM do painel virtual
+#include "hal.h"                            // hal_cycles: nanossegundos reais no host
+
+// Confere o arco inteiro do driver (oled_draw_arc) contra a rotina antiga,
+// que calculava cos/sin em ponto flutuante a cada grau e pintava um bloco
+// 2x2 em cada ponto. Os arcos das faces são desenhados pelas duas, cada um
+// no seu quadro, e comparados pixel a pixel.
+//
+// As duas não são idênticas, e não devem ser. Diferenças permitidas:
+// - a referência trunca cos/sin para zero e engrossa o traço para +x/+y,
+//   então o traço dela fica deslocado até 1 pixel do raio ideal;
+// - o novo traço tem 2 pixels de espessura em todos os ângulos (anel entre
+//   r-1 e r pelo critério do ponto médio), a referência tem 2 pixels nas
+//   direções dos eixos e até 3 nas diagonais, onde os blocos se sobrepõem;
+// - o bloco 2x2 das pontas da referência passa do setor angular (na
+//   tristeza, o pixel em 346 graus): fora do setor, pixels só dela não
+//   precisam de vizinho no novo traço.
+// Falhas (código de saída 1):
+// - pixel do novo arco fora do anel ideal (centro a mais de 0,5 pixel das
+//   bordas r-1,5 e r+0,5) ou fora do setor angular;
+// - pixel de um dos arcos (dentro do setor) a mais de 1 pixel (vizinhança
+//   3x3) de algum pixel do outro: os traços nunca se afastam;
+// - falha no novo traço: o ponto ideal de cada grau sem pixel vizinho.
+
+// ===== Parâmetros da Verificação =====
+#define ARC_CHECK_REPS 20000                // Repetições na medida de tempo
+#define ARC_CHECK_SECTOR_TOL_DEG 0.5        // Folga do setor (tabela Q14 por grau)
+
+typedef struct {
+    const char *name;
+    int cx, cy, radius, start, end;
+} arc_case_t;
+
+// Mesmos arcos das faces (tools/gen_face_sprites)
+static const arc_case_t casos[] = {
+    {"sorriso", 64, 32, 15, 20, 160},
+    {"tristeza", 64, 48, 12, 200, 340},
+};
+
+typedef bool frame_t[OLED_HEIGHT][OLED_WIDTH];
+
+// ===== REFERÊNCIA: ROTINA ANTIGA =====
+
+// oled_draw_arc antes do rasterizador inteiro, sem alterações
+static void arc_ref_draw(int cx, int cy, int radius, int start_angle, int end_angle, bool on) {
+    for (int angle = start_angle; angle <= end_angle; angle++) {
+        float rad = angle * M_PI / 180.0;
+        int x = cx + (int)(radius * cos(rad));
+        int y = cy + (int)(radius * sin(rad));
+        oled_set_pixel(x, y, on);
+
+        // Tornar a linha mais espessa
+        oled_set_pixel(x + 1, y, on);
+        oled_set_pixel(x, y + 1, on);
+        oled_set_pixel(x + 1, y + 1, on);
+    }
+}
+
+// ===== QUADROS =====
+
+// Desenha num quadro limpo e lê o resultado da GDDRAM do painel virtual
+static int render(frame_t f, bool ref, const arc_case_t *c) {
+    oled_clear();
+    if (ref) {
+        arc_ref_draw(c->cx, c->cy, c->radius, c->start, c->end, true);
+    } else {
+        oled_draw_arc(c->cx, c->cy, c->radius, c->start, c->end, true);
+    }
+    oled_update();
+
+    int n = 0;
+    for (int y = 0; y < OLED_HEIGHT; y++) {
+        for (int x = 0; x < OLED_WIDTH; x++) {
+            f[y][x] = ssd1306_sim_pixel(x, y);
+            n += f[y][x];
+        }
+    }
+    return n;
+}
+
+// Algum pixel aceso na vizinhança 3x3 de (x, y)
+static bool near(frame_t f, int x, int y) {
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int px = x + dx, py = y + dy;
+            if (px >= 0 && px < OLED_WIDTH && py >= 0 && py < OLED_HEIGHT && f[py][px]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Ângulo de (dx, dy) dentro do setor [start, end], com folga
+static bool in_sector(const arc_case_t *c, double dx, double dy) {
+    double a = atan2(dy, dx) * 180.0 / M_PI - c->start;
+    while (a < -ARC_CHECK_SECTOR_TOL_DEG) a += 360.0;
+    double sweep = c->end - c->start;
+    if (sweep < 0) sweep += 360.0;
+    return a <= sweep + ARC_CHECK_SECTOR_TOL_DEG;
+}
+
+// ===== COMPARAÇÃO =====
+
+static bool check_case(const arc_case_t *c) {
+    static frame_t ref, novo;
+    int n_ref = render(ref, true, c);
+    int n_novo = render(novo, false, c);
+
+    int so_ref = 0, so_novo = 0, fora_anel = 0, fora_setor = 0, longe = 0, falhas = 0;
+    for (int y = 0; y < OLED_HEIGHT; y++) {
+        for (int x = 0; x < OLED_WIDTH; x++) {
+            so_ref += ref[y][x] && !novo[y][x];
+            so_novo += novo[y][x] && !ref[y][x];
+            double dx = x - c->cx, dy = y - c->cy;
+            if (ref[y][x] && !near(novo, x, y) && in_sector(c, dx, dy)) longe++;
+            if (!novo[y][x]) continue;
+            if (!near(ref, x, y)) longe++;
+            double d = sqrt(dx * dx + dy * dy);
+            if (d <= c->radius - 1.5 || d > c->radius + 0.5) fora_anel++;
+            if (!in_sector(c, dx, dy)) fora_setor++;
+        }
+    }
+
+    // Sem falhas: o ponto ideal de cada grau tem pixel do novo traço ao lado
+    for (int a = c->start; a <= c->end; a++) {
+        double rad = a * M_PI / 180.0;
+        int x = (int)lround(c->cx + (c->radius - 0.5) * cos(rad));
+        int y = (int)lround(c->cy + (c->radius - 0.5) * sin(rad));
+        if (!near(novo, x, y)) falhas++;
+    }
+
+    // Tempo por arco: só a rasterização no back buffer, sem o envio
+    uint32_t t0 = hal_cycles();
+    for (int i = 0; i < ARC_CHECK_REPS; i++) {
+        arc_ref_draw(c->cx, c->cy, c->radius, c->start, c->end, true);
+    }
+    double ns_ref = (double)hal_cycles_elapsed(t0) / ARC_CHECK_REPS;
+    t0 = hal_cycles();
+    for (int i = 0; i < ARC_CHECK_REPS; i++) {
+        oled_draw_arc(c->cx, c->cy, c->radius, c->start, c->end, true);
+    }
+    double ns_novo = (double)hal_cycles_elapsed(t0) / ARC_CHECK_REPS;
+
+    bool ok = !fora_anel && !fora_setor && !longe && !falhas;
+    printf("%-9s r=%2d %3d..%3d  pixels %3d (ref %3d)  só ref %3d  só novo %3d  "
+           "%7.0f ns (ref %7.0f ns)  %s\n",
+           c->name, c->radius, c->start, c->end, n_novo, n_ref, so_ref, so_novo,
+           ns_novo, ns_ref, ok ? "ok" : "FALHOU");
+    if (!ok) {
+        printf("  fora do anel %d, fora do setor %d, sem vizinho no outro traço %d, "
+               "graus sem pixel %d\n", fora_anel, fora_setor, longe, falhas);
+    }
+    return ok;
+}
+
+int main(void) {
+    oled_i2c_init(0, 0, OLED_I2C_BAUDRATE);
+    oled_init();
+
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        ok &= check_case(&casos[i]);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "flash_store.h"                    // Interface da região do histórico
+#include "flash_store_sim.h"
+#include "hal.h"                            // Tempo de apagar/gravar no relógio virtual
+#include <stdio.h>
+#include <string.h>
+
+#define ERASE_US 45000                      // Apagamento típico de um setor de 4 KiB
+#define PROGRAM_US 400                      // Gravação típica de uma página
+
+static uint8_t flash[FLASH_STORE_SIZE];
+static bool initialized;
+
+static void ensure_init(void) {
+    if (!initialized) {
+        memset(flash, 0xFF, sizeof(flash));
+        initialized = true;
+    }
+}
+
+bool flash_store_sim_load(const char *path) {
+    ensure_init();
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;                       // Sem imagem: flash apagada
+    }
+    size_t n = fread(flash, 1, sizeof(flash), f);
+    fclose(f);
+    return n == sizeof(flash);
+}
+
+bool flash_store_sim_save(const char *path) {
+    ensure_init();
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    size_t n = fwrite(flash, 1, sizeof(flash), f);
+    fclose(f);
+    return n == sizeof(flash);
+}
+
+uint32_t flash_store_size(void) {
+    ensure_init();
+    return FLASH_STORE_SIZE;
+}
+
+const uint8_t *flash_store_read(uint32_t offset) {
+    ensure_init();
+    return &flash[offset];
+}
+
+bool flash_store_erase(uint32_t offset) {
+    ensure_init();
+    memset(&flash[offset & ~(FLASH_STORE_SECTOR_SIZE - 1)], 0xFF, FLASH_STORE_SECTOR_SIZE);
+    hal_sleep_us(ERASE_US);
+    return true;
+}
+
+bool flash_store_program(uint32_t offset, const uint8_t *page) {
+    ensure_init();
+    for (uint32_t i = 0; i < FLASH_STORE_PAGE_SIZE; i++) {
+        flash[offset + i] &= page[i];
+    }
+    hal_sleep_us(PROGRAM_US);
+    return true;
+}
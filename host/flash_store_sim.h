@@ -0,0 +1,14 @@
+#ifndef FLASH_STORE_SIM_H
+#define FLASH_STORE_SIM_H
+
+#include <stdbool.h>
+
+// Flash virtual do histórico (implementa flash_store.h). Segue a física da
+// NOR: apagar deixa 0xFF e gravar só leva bits de 1 para 0. Apagar e gravar
+// consomem o tempo típico da QSPI no relógio virtual, como a pausa real.
+
+// Imagem persistente entre execuções (simula reinicializações)
+bool flash_store_sim_load(const char *path);
+bool flash_store_sim_save(const char *path);
+
+#endif // FLASH_STORE_SIM_H
@@ -0,0 +1,65 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "hal.h"                            // Interface de tempo portável
+#include "sim_clock.h"                      // Controle do relógio virtual
+#include <time.h>                           // nanosleep e relógio real
+
+static uint64_t now_us;
+static double speed;                        // 0 = sem cadência real
+
+void sim_clock_set_speed(double factor) {
+    speed = factor > 0 ? factor : 0;
+}
+
+void sim_clock_reset(uint64_t t_us) {
+    now_us = t_us;
+}
+
+uint64_t hal_time_us(void) {
+    return now_us;
+}
+
+void hal_sleep_until_us(uint64_t t_us) {
+    if (t_us <= now_us) {
+        return;
+    }
+    if (speed > 0) {
+        double real_s = (double)(t_us - now_us) / 1e6 / speed;
+        struct timespec ts = {(time_t)real_s, (long)((real_s - (time_t)real_s) * 1e9)};
+        nanosleep(&ts, NULL);
+    }
+    now_us = t_us;
+}
+
+void hal_sleep_us(uint64_t us) {
+    hal_sleep_until_us(now_us + us);
+}
+
+// Não há outro núcleo para acordar antes: vai direto ao alvo
+void hal_wait_until_us(uint64_t t_us) {
+    if (t_us != UINT64_MAX) {
+        hal_sleep_until_us(t_us);
+    }
+}
+
+// Espera ativa: avança 1 µs para que laços de espera terminem
+void hal_idle(void) {
+    now_us++;
+}
+
+// Ciclos = nanossegundos reais: mede o custo do código no host
+void hal_cycles_init(void) {
+}
+
+uint32_t hal_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t hal_cycles_elapsed(uint32_t start) {
+    return hal_cycles() - start;
+}
+
+uint32_t hal_cycles_hz(void) {
+    return 1000000000u;
+}
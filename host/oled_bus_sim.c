@@ -0,0 +1,183 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "oled_bus.h"                       // Mesma interface do transporte I2C + DMA
+#include "ssd1306_sim.h"                    // Acesso ao painel virtual
+#include "oled_ssd1306.h"                   // Dimensões e comandos do SSD1306
+#include "hal.h"                            // Relógio virtual
+#include <stdio.h>
+#include <string.h>
+
+// ===== ESTADO DO CONTROLADOR VIRTUAL =====
+static uint8_t gddram[OLED_PAGES][OLED_WIDTH];
+static bool display_on;
+static uint8_t col_start, col_end = OLED_WIDTH - 1, col;
+static uint8_t page_start, page_end = OLED_PAGES - 1, page;
+
+// Decodificador do fluxo: cada transação começa com o byte de controle
+static bool in_transaction;
+static bool data_mode;
+static uint8_t cmd_buf[3];
+static int cmd_len;
+static uint32_t bytes_received;
+
+// Barramento: ocupado até 'bus_free_us'
+static uint32_t baud = 400000;
+static uint64_t bus_free_us;
+
+// Argumentos de cada comando (os demais não têm argumento)
+static int cmd_args(uint8_t cmd) {
+    switch (cmd) {
+        case SSD1306_COLUMN_ADDR:
+        case SSD1306_PAGE_ADDR:
+            return 2;
+        case SSD1306_SET_CONTRAST:
+        case SSD1306_SET_DISPLAY_OFFSET:
+        case SSD1306_SET_COM_PINS:
+        case SSD1306_SET_VCOM_DETECT:
+        case SSD1306_SET_DISPLAY_CLOCK_DIV:
+        case SSD1306_SET_PRECHARGE:
+        case SSD1306_SET_MULTIPLEX:
+        case SSD1306_MEMORY_MODE:
+        case SSD1306_CHARGE_PUMP:
+            return 1;
+    }
+    return 0;
+}
+
+static void run_command(void) {
+    switch (cmd_buf[0]) {
+        case SSD1306_COLUMN_ADDR:
+            col_start = col = cmd_buf[1] % OLED_WIDTH;
+            col_end = cmd_buf[2] % OLED_WIDTH;
+            break;
+        case SSD1306_PAGE_ADDR:
+            page_start = page = cmd_buf[1] % OLED_PAGES;
+            page_end = cmd_buf[2] % OLED_PAGES;
+            break;
+        case SSD1306_DISPLAY_ON:
+            display_on = true;
+            break;
+        case SSD1306_DISPLAY_OFF:
+            display_on = false;
+            break;
+    }
+    cmd_len = 0;
+}
+
+// Modo horizontal: avança a coluna e passa para a próxima página da janela
+static void write_data(uint8_t byte) {
+    gddram[page][col] = byte;
+    if (col == col_end) {
+        col = col_start;
+        page = page == page_end ? page_start : page + 1;
+    } else {
+        col = (col + 1) % OLED_WIDTH;
+    }
+}
+
+static void receive(uint16_t word) {
+    uint8_t byte = (uint8_t)word;
+    bytes_received++;
+    if (!in_transaction) {
+        in_transaction = true;
+        data_mode = (byte & 0x40) != 0;      // Byte de controle: D/C#
+        cmd_len = 0;
+    } else if (data_mode) {
+        write_data(byte);
+    } else {
+        cmd_buf[cmd_len++] = byte;
+        if (cmd_len > cmd_args(cmd_buf[0])) {
+            run_command();
+        }
+    }
+    if (word & OLED_BUS_STOP) {
+        in_transaction = false;
+    }
+}
+
+// Ocupa o barramento: 9 bits por byte (8 de dados + ACK)
+static void bus_transfer(uint32_t bytes) {
+    uint64_t now = hal_time_us();
+    if (bus_free_us < now) {
+        bus_free_us = now;
+    }
+    bus_free_us += (uint64_t)bytes * 9u * 1000000u / baud;
+}
+
+uint32_t oled_bus_init(uint32_t sda, uint32_t scl, uint32_t baudrate) {
+    (void)sda;
+    (void)scl;
+    baud = baudrate;
+    return baud;
+}
+
+bool oled_bus_write(const uint8_t *buf, size_t len) {
+    bus_transfer(len + 1);                  // + byte de endereço
+    for (size_t i = 0; i < len; i++) {
+        receive(buf[i] | (i + 1 == len ? OLED_BUS_STOP : 0));
+    }
+    hal_sleep_until_us(bus_free_us);        // Bloqueante, como i2c_write_blocking
+    return true;
+}
+
+void oled_bus_begin(void) {
+}
+
+// FIFO de 16 palavras: esvazia no ritmo do barramento
+size_t oled_bus_space(void) {
+    return hal_time_us() >= bus_free_us ? 16 : 0;
+}
+
+void oled_bus_put(uint16_t word) {
+    bus_transfer(in_transaction ? 1 : 2);   // Início de transação inclui o endereço
+    receive(word);
+}
+
+void oled_bus_put_dma(const uint16_t *words, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        oled_bus_put(words[i]);
+    }
+}
+
+bool oled_bus_dma_busy(void) {
+    return hal_time_us() < bus_free_us;
+}
+
+bool oled_bus_idle(void) {
+    return hal_time_us() >= bus_free_us && !in_transaction;
+}
+
+bool oled_bus_take_abort(void) {
+    return false;                           // O painel virtual sempre responde
+}
+
+// ===== ACESSO AO PAINEL =====
+bool ssd1306_sim_pixel(int x, int y) {
+    return (gddram[y >> 3][x] >> (y & 7)) & 1;
+}
+
+bool ssd1306_sim_display_on(void) {
+    return display_on;
+}
+
+uint32_t ssd1306_sim_bytes(void) {
+    return bytes_received;
+}
+
+bool ssd1306_sim_write_pbm(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "P4\n%d %d\n", OLED_WIDTH, OLED_HEIGHT);
+    for (int y = 0; y < OLED_HEIGHT; y++) {
+        uint8_t row[OLED_WIDTH / 8];
+        memset(row, 0xFF, sizeof(row));     // PBM: 1 = preto, MSB à esquerda
+        for (int x = 0; x < OLED_WIDTH; x++) {
+            if (display_on && ssd1306_sim_pixel(x, y)) {
+                row[x >> 3] &= ~(0x80 >> (x & 7));   // Pixel aceso = branco
+            }
+        }
+        fwrite(row, 1, sizeof(row), f);
+    }
+    return fclose(f) == 0;
+}
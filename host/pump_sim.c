@@ -0,0 +1,85 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "pump.h"                           // Mesma API da bomba real
+#include "pump_sim.h"                       // Contabilidade da bomba virtual
+#include "hal.h"                            // Relógio virtual
+
+typedef struct {
+    bool on;
+    uint64_t on_since_us;
+    uint64_t deadline_us;                   // Alarme de segurança (0 = nenhum)
+    uint64_t off_us;
+    uint64_t total_on_us;
+    uint32_t starts;
+} pump_sim_t;
+
+static pump_sim_t pumps[PUMP_MAX];
+static uint32_t running;
+static uint32_t max_running;
+
+static void pump_off_at(pump_sim_t *p, uint64_t t_us) {
+    if (p->on) {
+        p->total_on_us += t_us - p->on_since_us;
+        running--;
+    }
+    p->on = false;
+    p->deadline_us = 0;
+    p->off_us = t_us;
+}
+
+// Equivalente ao callback do alarme: dispara no prazo, mesmo entre passos
+static void check_alarms(void) {
+    for (uint32_t i = 0; i < PUMP_MAX; i++) {
+        pump_sim_t *p = &pumps[i];
+        if (p->on && p->deadline_us && hal_time_us() >= p->deadline_us) {
+            pump_off_at(p, p->deadline_us);
+        }
+    }
+}
+
+void pump_init(uint32_t id, uint32_t gpio) {
+    (void)gpio;
+    pump_off_at(&pumps[id], hal_time_us());
+}
+
+void pump_start(uint32_t id, uint32_t max_on_ms) {
+    check_alarms();
+    pump_sim_t *p = &pumps[id];
+    if (!p->on) {
+        p->on_since_us = hal_time_us();
+        p->starts++;
+        if (++running > max_running) {
+            max_running = running;
+        }
+    }
+    p->on = true;
+    p->deadline_us = hal_time_us() + (uint64_t)max_on_ms * 1000u;
+}
+
+void pump_stop(uint32_t id) {
+    check_alarms();
+    pump_off_at(&pumps[id], hal_time_us());
+}
+
+bool pump_is_on(uint32_t id) {
+    check_alarms();
+    return pumps[id].on;
+}
+
+uint64_t pump_last_off_us(uint32_t id) {
+    check_alarms();
+    return pumps[id].off_us;
+}
+
+uint64_t pump_sim_total_on_us(uint32_t id) {
+    check_alarms();
+    const pump_sim_t *p = &pumps[id];
+    return p->total_on_us + (p->on ? hal_time_us() - p->on_since_us : 0);
+}
+
+uint32_t pump_sim_starts(uint32_t id) {
+    return pumps[id].starts;
+}
+
+uint32_t pump_sim_max_concurrent(void) {
+    return max_running;
+}
@@ -0,0 +1,14 @@
+#ifndef PUMP_SIM_H
+#define PUMP_SIM_H
+
+#include <stdint.h>
+
+// Tempo total com a bomba virtual ligada até agora, incluindo o
+// desligamento pelo alarme de segurança no instante exato do prazo
+uint64_t pump_sim_total_on_us(uint32_t id);
+uint32_t pump_sim_starts(uint32_t id);
+
+// Maior número de bombas ligadas ao mesmo tempo (verifica o orçamento)
+uint32_t pump_sim_max_concurrent(void);
+
+#endif // PUMP_SIM_H
@@ -0,0 +1,110 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "replay_hal.h"                     // Relógio e bombas por thread
+#include "hal.h"                            // Mesma interface de tempo do firmware
+#include "pump.h"                           // Mesma API da bomba
+#include <string.h>
+
+typedef struct {
+    bool on;
+    uint64_t on_since_us;
+    uint64_t deadline_us;                   // Alarme de segurança (0 = nenhum)
+    uint64_t off_us;
+    uint64_t total_on_us;
+    uint32_t starts;
+} replay_pump_t;
+
+// ===== ESTADO POR THREAD =====
+static _Thread_local uint64_t now_us;
+static _Thread_local replay_pump_t pumps[PUMP_MAX];
+
+void replay_hal_reset(void) {
+    now_us = 0;
+    memset(pumps, 0, sizeof(pumps));
+}
+
+void replay_clock_set(uint64_t t_us) {
+    if (t_us > now_us) {
+        now_us = t_us;
+    }
+}
+
+// ===== hal.h =====
+uint64_t hal_time_us(void) {
+    return now_us;
+}
+
+void hal_sleep_until_us(uint64_t t_us) {
+    replay_clock_set(t_us);
+}
+
+void hal_sleep_us(uint64_t us) {
+    now_us += us;
+}
+
+void hal_wait_until_us(uint64_t t_us) {
+    if (t_us != UINT64_MAX) {
+        hal_sleep_until_us(t_us);
+    }
+}
+
+void hal_idle(void) {
+    now_us++;
+}
+
+// ===== pump.h =====
+static void pump_off_at(replay_pump_t *p, uint64_t t_us) {
+    if (p->on) {
+        p->total_on_us += t_us - p->on_since_us;
+    }
+    p->on = false;
+    p->deadline_us = 0;
+    p->off_us = t_us;
+}
+
+// Equivalente ao callback do alarme: dispara no prazo, mesmo entre passos
+static void check_alarm(replay_pump_t *p) {
+    if (p->on && p->deadline_us && now_us >= p->deadline_us) {
+        pump_off_at(p, p->deadline_us);
+    }
+}
+
+void pump_init(uint32_t id, uint32_t gpio) {
+    (void)gpio;
+    pump_off_at(&pumps[id], now_us);
+}
+
+void pump_start(uint32_t id, uint32_t max_on_ms) {
+    replay_pump_t *p = &pumps[id];
+    check_alarm(p);
+    if (!p->on) {
+        p->on_since_us = now_us;
+        p->starts++;
+    }
+    p->on = true;
+    p->deadline_us = now_us + (uint64_t)max_on_ms * 1000u;
+}
+
+void pump_stop(uint32_t id) {
+    check_alarm(&pumps[id]);
+    pump_off_at(&pumps[id], now_us);
+}
+
+bool pump_is_on(uint32_t id) {
+    check_alarm(&pumps[id]);
+    return pumps[id].on;
+}
+
+uint64_t pump_last_off_us(uint32_t id) {
+    check_alarm(&pumps[id]);
+    return pumps[id].off_us;
+}
+
+uint64_t replay_pump_on_us(uint32_t id) {
+    replay_pump_t *p = &pumps[id];
+    check_alarm(p);
+    return p->total_on_us + (p->on ? now_us - p->on_since_us : 0);
+}
+
+uint32_t replay_pump_starts(uint32_t id) {
+    return pumps[id].starts;
+}
@@ -0,0 +1,18 @@
+#ifndef REPLAY_HAL_H
+#define REPLAY_HAL_H
+
+#include <stdint.h>
+
+// Relógio e bombas do replay de traços (implementa hal.h e pump.h). Todo o
+// estado é por thread: cada worker do pool executa o mesmo plant_control_step
+// do firmware em paralelo, sem compartilhar nada com os outros.
+
+void replay_hal_reset(void);                // Relógio em 0, bombas desligadas
+void replay_clock_set(uint64_t t_us);       // Só avança
+
+// Tempo com a bomba ligada até agora, com o desligamento pelo alarme de
+// segurança no instante exato do prazo
+uint64_t replay_pump_on_us(uint32_t id);
+uint32_t replay_pump_starts(uint32_t id);
+
+#endif // REPLAY_HAL_H
@@ -0,0 +1,593 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include <stdio.h>                          // Entrada e saída padrão
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>                         // Opções de linha de comando
+#include <math.h>
+#include <time.h>                           // Tempo real (horas simuladas por minuto)
+#include "replay_hal.h"                     // Relógio e bombas por thread
+#include "work_pool.h"                      // Pool com roubo de trabalho
+#include "soil_model.h"                     // Mesma física do simulador
+#include "plant_control.h"                  // Mesmo controle do firmware
+
+// Replay de traços no Linux: a mesma decisão de irrigação do firmware
+// (plant_control_step → dosagem, máquina de estados e bomba, e o escalonador)
+// sobre milhares de traços, para cada combinação de uma grade de parâmetros,
+// em todos os núcleos da CPU.
+//
+// Um traço descreve o ambiente de um vaso: perda de água em cada hora do dia,
+// vazão da bomba, atraso da infiltração e ruído do sensor. A leitura é
+// fechada em malha pelo modelo do solo do simulador, porque depende do que
+// a bomba fez; traços gravados (CSV das amostras do telemetry_decode)
+// contribuem com a perda medida hora a hora.
+
+// ===== Parâmetros do Replay =====
+#define REPLAY_DEFAULT_TRACES 1000
+#define REPLAY_DEFAULT_DAYS 7.0
+#define REPLAY_DEFAULT_ACTIVE_HZ 100        // Leituras por segundo irrigando (taxa do core0)
+#define REPLAY_DEFAULT_IDLE_S 5.0           // Leituras espaçadas ocioso ou bloqueado (como o baixo consumo)
+#define REPLAY_DEFAULT_BAND_LO_ML 12.0      // Faixa adequada do vaso: avaliação, não controle
+#define REPLAY_DEFAULT_BAND_HI_ML 20.0
+#define REPLAY_MAX_GRID 16                  // Valores por parâmetro da grade
+#define REPLAY_MAX_FILES 64                 // Traços gravados
+#define REPLAY_GAP_US 10000000              // Amostras mais espaçadas que isso não medem a perda
+#define REPLAY_MIN_HOUR_US 600000000ull     // Hora com menos de 10 min medidos usa a média
+#define HOURS_PER_DAY 24
+#define US_PER_HOUR 3600000000ull
+
+// ===== TRAÇOS =====
+typedef struct {
+    float start_ml;
+    float flow_ml_s;
+    float lag_s;
+    float noise_lsb;
+    float loss_ml_h[HOURS_PER_DAY];         // Perda em cada hora do dia (repete a cada dia)
+    uint32_t seed;                          // Ruído do sensor
+} replay_trace_t;
+
+// ===== GRADE DE PARÂMETROS =====
+typedef struct {
+    uint16_t dry_cml;
+    uint16_t wet_cml;
+    uint16_t target_cml;
+    uint32_t max_dose_ms;
+    uint8_t dose_mode;                      // dose_mode_t
+} replay_config_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t values[REPLAY_MAX_GRID];
+} grid_axis_t;
+
+// ===== RESULTADOS =====
+typedef struct {
+    double pumped_ml;
+    uint64_t sim_us;
+    uint64_t below_us;                      // Água abaixo da faixa adequada
+    uint64_t above_us;                      // Acima da faixa
+    uint64_t steps;                         // Passos de controle executados
+    uint32_t pump_starts;
+    uint32_t cycles;                        // Ciclos de irrigação terminados
+    uint32_t lockouts;                      // ... dos quais bloqueados
+} replay_result_t;
+
+// ===== OPÇÕES =====
+typedef struct {
+    uint32_t traces;
+    double days;
+    uint32_t seed;
+    uint32_t threads;
+    uint32_t active_hz;
+    double idle_s;
+    double band_lo_ml;
+    double band_hi_ml;
+    const char *files[REPLAY_MAX_FILES];
+    uint32_t file_count;
+    uint32_t file_zone;
+    grid_axis_t dry, wet, target, max_dose, mode;
+    const char *out_path;
+} replay_options_t;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opções]\n"
+            "  --traces N       traços sintéticos (padrão %d; 0 = só os gravados)\n"
+            "  --trace ARQ      traço gravado: CSV das amostras do telemetry_decode\n"
+            "                   (repetível; a perda de cada hora vem da queda da água\n"
+            "                   com a bomba desligada)\n"
+            "  --trace-zone Z   zona usada dos traços gravados (padrão 0)\n"
+            "  --days D         dias simulados por traço (padrão %.0f)\n"
+            "  --seed N         semente dos traços sintéticos (padrão 1)\n"
+            "  --threads N      workers (padrão: um por CPU)\n"
+            "  --active-hz HZ   leituras por segundo irrigando/encharcando (padrão %d)\n"
+            "  --idle-s S       intervalo das leituras ocioso ou bloqueado (padrão %.0f s)\n"
+            "  --band LO:HI     faixa adequada do vaso para as métricas (padrão %.0f:%.0f mL)\n"
+            "  --out ARQ        CSV com uma linha por configuração (padrão: saída padrão)\n"
+            "Grade (listas separadas por vírgula; padrão: os valores do firmware):\n"
+            "  --dry ML,...     limiar de solo seco (padrão %.0f mL)\n"
+            "  --wet ML,...     limiar de encharcado (padrão %.0f mL)\n"
+            "  --target ML,...  alvo de cada ciclo (padrão %.0f mL)\n"
+            "  --max-dose S,... dose mais longa (padrão %.0f s)\n"
+            "  --mode M,...     model e/ou pi (padrão model)\n",
+            prog, REPLAY_DEFAULT_TRACES, REPLAY_DEFAULT_DAYS, REPLAY_DEFAULT_ACTIVE_HZ,
+            REPLAY_DEFAULT_IDLE_S, REPLAY_DEFAULT_BAND_LO_ML, REPLAY_DEFAULT_BAND_HI_ML,
+            SOIL_DRY_WATER_CML / 100.0, SOIL_WET_WATER_CML / 100.0, SOIL_TARGET_WATER_CML / 100.0,
+            PUMP_DOSE_MS / 1000.0);
+}
+
+// Lista "a,b,c" multiplicada por 'scale' (mL → cml, s → ms)
+static bool parse_axis(const char *arg, double scale, grid_axis_t *axis) {
+    axis->count = 0;
+    const char *p = arg;
+    while (*p) {
+        char *end;
+        double v = strtod(p, &end);
+        if (end == p || v < 0 || axis->count == REPLAY_MAX_GRID) {
+            return false;
+        }
+        axis->values[axis->count++] = (uint32_t)(v * scale + 0.5);
+        p = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') {
+            return false;
+        }
+    }
+    return axis->count > 0;
+}
+
+static bool parse_modes(const char *arg, grid_axis_t *axis) {
+    axis->count = 0;
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%s", arg);
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        if (axis->count == REPLAY_MAX_GRID) return false;
+        if (strcmp(tok, "model") == 0) {
+            axis->values[axis->count++] = DOSE_MODE_MODEL;
+        } else if (strcmp(tok, "pi") == 0) {
+            axis->values[axis->count++] = DOSE_MODE_PI;
+        } else {
+            return false;
+        }
+    }
+    return axis->count > 0;
+}
+
+static bool parse_options(int argc, char **argv, replay_options_t *opt) {
+    static const struct option longopts[] = {
+        {"traces",     required_argument, 0, 'n'},
+        {"trace",      required_argument, 0, 'T'},
+        {"trace-zone", required_argument, 0, 'z'},
+        {"days",       required_argument, 0, 'd'},
+        {"seed",       required_argument, 0, 's'},
+        {"threads",    required_argument, 0, 'j'},
+        {"active-hz",  required_argument, 0, 'a'},
+        {"idle-s",     required_argument, 0, 'i'},
+        {"band",       required_argument, 0, 'b'},
+        {"out",        required_argument, 0, 'o'},
+        {"dry",        required_argument, 0, 'D'},
+        {"wet",        required_argument, 0, 'W'},
+        {"target",     required_argument, 0, 'A'},
+        {"max-dose",   required_argument, 0, 'P'},
+        {"mode",       required_argument, 0, 'M'},
+        {0, 0, 0, 0},
+    };
+    *opt = (replay_options_t){
+        .traces = REPLAY_DEFAULT_TRACES,
+        .days = REPLAY_DEFAULT_DAYS,
+        .seed = 1,
+        .active_hz = REPLAY_DEFAULT_ACTIVE_HZ,
+        .idle_s = REPLAY_DEFAULT_IDLE_S,
+        .band_lo_ml = REPLAY_DEFAULT_BAND_LO_ML,
+        .band_hi_ml = REPLAY_DEFAULT_BAND_HI_ML,
+        .dry = {1, {SOIL_DRY_WATER_CML}},
+        .wet = {1, {SOIL_WET_WATER_CML}},
+        .target = {1, {SOIL_TARGET_WATER_CML}},
+        .max_dose = {1, {PUMP_DOSE_MS}},
+        .mode = {1, {DOSE_MODE}},
+    };
+    int c;
+    bool ok = true;
+    while ((c = getopt_long(argc, argv, "", longopts, NULL)) != -1) {
+        switch (c) {
+            case 'n': opt->traces = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'T':
+                if (opt->file_count == REPLAY_MAX_FILES) return false;
+                opt->files[opt->file_count++] = optarg;
+                break;
+            case 'z': opt->file_zone = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': opt->days = atof(optarg); break;
+            case 's': opt->seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'j': opt->threads = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'a': opt->active_hz = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'i': opt->idle_s = atof(optarg); break;
+            case 'b': ok &= sscanf(optarg, "%lf:%lf", &opt->band_lo_ml, &opt->band_hi_ml) == 2; break;
+            case 'o': opt->out_path = optarg; break;
+            case 'D': ok &= parse_axis(optarg, 100, &opt->dry); break;
+            case 'W': ok &= parse_axis(optarg, 100, &opt->wet); break;
+            case 'A': ok &= parse_axis(optarg, 100, &opt->target); break;
+            case 'P': ok &= parse_axis(optarg, 1000, &opt->max_dose); break;
+            case 'M': ok &= parse_modes(optarg, &opt->mode); break;
+            default: return false;
+        }
+    }
+    return ok && optind == argc && opt->days > 0 && opt->active_hz > 0 && opt->idle_s > 0 &&
+           opt->traces + opt->file_count > 0;
+}
+
+// ===== ALEATÓRIOS =====
+// xorshift32: cada traço tem a sua sequência, igual em todas as configurações
+static uint32_t next_u32(uint32_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+static float uniform(uint32_t *s) {
+    return (next_u32(s) >> 8) * (1.0f / 16777216.0f);
+}
+
+static float between(uint32_t *s, float lo, float hi) {
+    return lo + (hi - lo) * uniform(s);
+}
+
+// Soma de 4 uniformes (Irwin-Hall): quase gaussiana, sem log/cos por leitura
+static float gaussian(uint32_t *s) {
+    return (uniform(s) + uniform(s) + uniform(s) + uniform(s) - 2.0f) * 1.7320508f;
+}
+
+// Vasos variados: planta maior ou menor, tarde quente, bomba e solo diferentes
+static void synthetic_trace(replay_trace_t *tr, uint32_t seed, uint32_t index) {
+    uint32_t s = (seed * 2654435761u) ^ (index * 2246822519u) ^ 0x9E3779B9u;
+    if (s == 0) s = 1;
+    tr->start_ml = between(&s, 10.0f, 18.0f);
+    tr->flow_ml_s = between(&s, 0.25f, 1.5f);
+    tr->lag_s = between(&s, 3.0f, 20.0f);
+    tr->noise_lsb = between(&s, 0.5f, 4.0f);
+    float base = between(&s, 0.3f, 3.0f);
+    float swing = between(&s, 0.0f, 0.9f);  // Diferença dia/noite
+    float peak_h = between(&s, 12.0f, 16.0f);
+    for (int h = 0; h < HOURS_PER_DAY; h++) {
+        tr->loss_ml_h[h] = base * (1.0f + swing * cosf(6.2831853f * (h + 0.5f - peak_h) / 24));
+    }
+    tr->seed = next_u32(&s) | 1u;
+}
+
+// Coluna 'name' na linha de cabeçalho do CSV; -1 = ausente
+static int csv_column(const char *header, const char *name) {
+    int col = 0;
+    size_t len = strlen(name);
+    for (const char *p = header; p; p = strchr(p, ','), p = p ? p + 1 : NULL, col++) {
+        if (strncmp(p, name, len) == 0 && (p[len] == ',' || p[len] == '\n' || p[len] == '\r' ||
+                                           p[len] == '\0')) {
+            return col;
+        }
+    }
+    return -1;
+}
+
+// Perda de cada hora desde o início da gravação: soma das quedas da água
+// entre amostras seguidas com a bomba desligada e a zona ociosa (no
+// encharcamento a água ainda sobe). Horas sem medida usam a média.
+static bool recorded_trace(const char *path, uint32_t zone, uint32_t index,
+                           replay_trace_t *tr) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char line[512];
+    if (!fgets(line, sizeof(line), f)) {
+        fclose(f);
+        return false;
+    }
+    int col_t = csv_column(line, "t_us"), col_zone = csv_column(line, "zone");
+    int col_water = csv_column(line, "water_ml"), col_pump = csv_column(line, "pump");
+    int col_state = csv_column(line, "state");
+    if (col_t < 0 || col_zone < 0 || col_water < 0 || col_pump < 0 || col_state < 0) {
+        fprintf(stderr, "%s: não é um CSV de amostras do telemetry_decode\n", path);
+        fclose(f);
+        return false;
+    }
+
+    double drop_ml[HOURS_PER_DAY] = {0};
+    uint64_t span_us[HOURS_PER_DAY] = {0};
+    bool have_prev = false, first = true;
+    uint64_t t0 = 0, prev_t = 0;
+    double prev_water = 0;
+    while (fgets(line, sizeof(line), f)) {
+        uint64_t t = 0;
+        double water = 0;
+        long z = -1, pump = 1;
+        bool idle = false;
+        int col = 0;
+        for (char *p = line; p; p = strchr(p, ','), p = p ? p + 1 : NULL, col++) {
+            if (col == col_t) t = strtoull(p, NULL, 10);
+            else if (col == col_zone) z = strtol(p, NULL, 10);
+            else if (col == col_water) water = strtod(p, NULL);
+            else if (col == col_pump) pump = strtol(p, NULL, 10);
+            else if (col == col_state) idle = strncmp(p, "ocioso", 6) == 0 || strncmp(p, "bloqueado", 9) == 0;
+        }
+        if (z != (long)zone) {
+            continue;
+        }
+        if (first) {
+            first = false;
+            t0 = t;
+            tr->start_ml = (float)water;
+        }
+        bool usable = pump == 0 && idle;
+        if (have_prev && usable && t > prev_t && t - prev_t < REPLAY_GAP_US) {
+            uint32_t h = (uint32_t)((t - t0) / US_PER_HOUR % HOURS_PER_DAY);
+            drop_ml[h] += prev_water - water;
+            span_us[h] += t - prev_t;
+        }
+        have_prev = usable;
+        prev_t = t;
+        prev_water = water;
+    }
+    fclose(f);
+
+    double total_drop = 0;
+    uint64_t total_span = 0;
+    for (int h = 0; h < HOURS_PER_DAY; h++) {
+        total_drop += drop_ml[h];
+        total_span += span_us[h];
+    }
+    if (total_span < REPLAY_MIN_HOUR_US) {
+        fprintf(stderr, "%s: zona %lu sem tempo ocioso suficiente para medir a perda\n", path,
+                (unsigned long)zone);
+        return false;
+    }
+    double mean = total_drop / total_span * US_PER_HOUR;
+    for (int h = 0; h < HOURS_PER_DAY; h++) {
+        double rate = span_us[h] >= REPLAY_MIN_HOUR_US ? drop_ml[h] / span_us[h] * US_PER_HOUR : mean;
+        tr->loss_ml_h[h] = rate > 0 ? (float)rate : 0.0f;
+    }
+    tr->flow_ml_s = SOIL_DEFAULT_FLOW_ML_S;
+    tr->lag_s = SOIL_DEFAULT_LAG_S;
+    tr->noise_lsb = 2.0f;
+    tr->seed = index * 2654435761u | 1u;
+    return true;
+}
+
+// ===== REPLAY DE UM TRAÇO =====
+typedef struct {
+    const replay_options_t *opt;
+    const replay_config_t *configs;
+    const replay_trace_t *traces;
+    uint32_t trace_count;
+    replay_result_t *results;
+} replay_job_ctx_t;
+
+// Mesmo ADC do simulador: média de 256 amostras de 12 bits com ruído
+static adc_sampler_reading_t sensor_reading(float volts, float noise_lsb, uint32_t *rng,
+                                            uint64_t t_us) {
+    float mean = volts * 4095.0f / 3.3f + gaussian(rng) * noise_lsb / 16.0f;
+    if (mean < 0) mean = 0;
+    if (mean > 4095.0f) mean = 4095.0f;
+    uint32_t sum = (uint32_t)(mean * 256 + 0.5f);
+    return (adc_sampler_reading_t){
+        .value = sum >> 4,
+        .mean = (uint16_t)(sum >> 8),
+        .bits = 16,
+        .input = plant_zones[0].adc_input,
+        .mux = plant_zones[0].mux_channel,
+        .timestamp_us = t_us,
+    };
+}
+
+static void replay(const replay_options_t *opt, const replay_config_t *cfg,
+                   const replay_trace_t *tr, replay_result_t *out) {
+    replay_hal_reset();
+    soil_model_t solo;
+    soil_model_init(&solo, tr->start_ml);
+    solo.flow_ml_s = tr->flow_ml_s;
+    solo.lag_s = tr->lag_s;
+
+    // Zona 0 da tabela com os limiares da configuração, como o simulador faz com --dose-mode
+    plant_zone_config_t linha = plant_zones[0];
+    linha.dry_water_cml = cfg->dry_cml;
+    linha.wet_water_cml = cfg->wet_cml;
+    linha.target_water_cml = cfg->target_cml;
+    plant_zone_t zona;
+    plant_control_init(&zona, 0);
+    zona.cfg = &linha;
+    zona.fsm.cfg.dose_ms = cfg->max_dose_ms;
+    zona.dose.cfg.max_dose_ms = cfg->max_dose_ms;
+    zona.dose.cfg.target_cml = cfg->target_cml;
+    zona.dose.cfg.mode = cfg->dose_mode;
+    plant_control_set_calib(&zona, &soil_calib_default);
+    pump_init(0, linha.pump_gpio);
+
+    const uint64_t fim = (uint64_t)(opt->days * 86400e6);
+    const uint64_t ativo_us = 1000000u / opt->active_hz;
+    const uint64_t ocioso_us = (uint64_t)(opt->idle_s * 1e6);
+    const float faixa_lo = (float)opt->band_lo_ml, faixa_hi = (float)opt->band_hi_ml;
+    uint32_t rng = tr->seed;
+    uint64_t t = 0, bomba_ant_us = 0;
+    *out = (replay_result_t){0};
+    while (t < fim) {
+        // Irrigando, encharcando ou esperando a vez: na taxa do core0. Ocioso
+        // ou bloqueado, leituras espaçadas (sem passar do fim do bloqueio).
+        const irrigation_fsm_t *fsm = &zona.fsm;
+        bool ativo = fsm->state == IRRIGATION_DOSING || fsm->state == IRRIGATION_SOAKING ||
+                     fsm->dose_wanted;
+        uint64_t dt = ativo ? ativo_us : ocioso_us;
+        if (!ativo && fsm->deadline_us > t && fsm->deadline_us - t < dt) {
+            dt = fsm->deadline_us - t;
+        }
+        t += dt;
+        replay_clock_set(t);
+
+        // --- Física: água bombeada desde o último passo ---
+        uint64_t bomba_us = replay_pump_on_us(0);
+        solo.loss_ml_h = tr->loss_ml_h[t / US_PER_HOUR % HOURS_PER_DAY];
+        soil_model_step(&solo, dt / 1e6f, (bomba_us - bomba_ant_us) / 1e6f);
+        bomba_ant_us = bomba_us;
+        if (solo.water_ml < faixa_lo) {
+            out->below_us += dt;
+        } else if (solo.water_ml > faixa_hi) {
+            out->above_us += dt;
+        }
+
+        // --- Controle: exatamente o passo do firmware ---
+        adc_sampler_reading_t leitura = sensor_reading(soil_model_voltage(&solo), tr->noise_lsb,
+                                                       &rng, t);
+        uint32_t latencia;
+        plant_control_step(&zona, &leitura, t, &latencia);
+        plant_control_schedule(&zona, 1, PUMP_SUPPLY_BUDGET_MA, t);
+        dose_cycle_report_t ciclo;
+        if (plant_control_take_cycle(&zona, &ciclo)) {
+            out->cycles++;
+            out->lockouts += ciclo.aborted;
+        }
+        out->steps++;
+    }
+    out->pumped_ml = solo.pumped_ml;
+    out->pump_starts = replay_pump_starts(0);
+    out->sim_us = t;
+}
+
+// Jobs intercalados: job = traço × configuração, com as configurações
+// vizinhas espalhadas entre as faixas dos workers
+static void run_job(uint32_t job, uint32_t worker, void *arg) {
+    (void)worker;
+    replay_job_ctx_t *ctx = arg;
+    uint32_t config = job / ctx->trace_count, trace = job % ctx->trace_count;
+    replay(ctx->opt, &ctx->configs[config], &ctx->traces[trace], &ctx->results[job]);
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    static replay_options_t opt;
+    if (!parse_options(argc, argv, &opt)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // === Traços: sintéticos e gravados ===
+    uint32_t n_tracos = opt.traces + opt.file_count;
+    replay_trace_t *tracos = calloc(n_tracos, sizeof(replay_trace_t));
+    for (uint32_t i = 0; i < opt.traces; i++) {
+        synthetic_trace(&tracos[i], opt.seed, i);
+    }
+    for (uint32_t i = 0; i < opt.file_count; i++) {
+        if (!recorded_trace(opt.files[i], opt.file_zone, opt.traces + i, &tracos[opt.traces + i])) {
+            return 1;
+        }
+    }
+
+    // === Grade: só combinações coerentes (seco < alvo < encharcado) ===
+    uint32_t maximo = opt.dry.count * opt.wet.count * opt.target.count * opt.max_dose.count *
+                      opt.mode.count;
+    replay_config_t *configs = calloc(maximo, sizeof(replay_config_t));
+    uint32_t n_configs = 0;
+    for (uint32_t a = 0; a < opt.dry.count; a++)
+    for (uint32_t b = 0; b < opt.wet.count; b++)
+    for (uint32_t c = 0; c < opt.target.count; c++)
+    for (uint32_t d = 0; d < opt.max_dose.count; d++)
+    for (uint32_t e = 0; e < opt.mode.count; e++) {
+        replay_config_t k = {
+            .dry_cml = (uint16_t)opt.dry.values[a],
+            .wet_cml = (uint16_t)opt.wet.values[b],
+            .target_cml = (uint16_t)opt.target.values[c],
+            .max_dose_ms = opt.max_dose.values[d],
+            .dose_mode = (uint8_t)opt.mode.values[e],
+        };
+        if (k.dry_cml < k.target_cml && k.target_cml < k.wet_cml && k.max_dose_ms >= DOSE_MIN_MS) {
+            configs[n_configs++] = k;
+        }
+    }
+    if (n_configs == 0) {
+        fprintf(stderr, "Nenhuma configuração coerente na grade (seco < alvo < encharcado)\n");
+        return 2;
+    }
+
+    // === Execução paralela ===
+    uint32_t n_jobs = n_configs * n_tracos;
+    replay_result_t *resultados = calloc(n_jobs, sizeof(replay_result_t));
+    replay_job_ctx_t ctx = {
+        .opt = &opt,
+        .configs = configs,
+        .traces = tracos,
+        .trace_count = n_tracos,
+        .results = resultados,
+    };
+    work_pool_stats_t pool;
+    double inicio = now_s();
+    work_pool_run(n_jobs, opt.threads, run_job, &ctx, &pool);
+    double real_s = now_s() - inicio;
+
+    // === Métricas por configuração (mesmos traços em todas: comparação pareada) ===
+    FILE *out = stdout;
+    if (opt.out_path) {
+        out = fopen(opt.out_path, "w");
+        if (!out) {
+            perror(opt.out_path);
+            return 1;
+        }
+    }
+    fprintf(out, "dry_ml,wet_ml,target_ml,max_dose_s,mode,traces,days,water_ml_day,"
+                 "pump_starts_day,cycles_day,lockouts_day,below_pct,above_pct,out_of_band_pct\n");
+    double sim_us_total = 0, passos = 0;
+    uint32_t melhor = 0;
+    double melhor_fora = 2, melhor_agua = 0;
+    for (uint32_t k = 0; k < n_configs; k++) {
+        replay_result_t soma = {0};
+        for (uint32_t i = 0; i < n_tracos; i++) {
+            const replay_result_t *r = &resultados[k * n_tracos + i];
+            soma.pumped_ml += r->pumped_ml;
+            soma.sim_us += r->sim_us;
+            soma.below_us += r->below_us;
+            soma.above_us += r->above_us;
+            soma.steps += r->steps;
+            soma.pump_starts += r->pump_starts;
+            soma.cycles += r->cycles;
+            soma.lockouts += r->lockouts;
+        }
+        sim_us_total += soma.sim_us;
+        passos += soma.steps;
+        double dias = soma.sim_us / 86400e6;
+        double abaixo = (double)soma.below_us / soma.sim_us, acima = (double)soma.above_us / soma.sim_us;
+        const replay_config_t *c = &configs[k];
+        fprintf(out, "%.2f,%.2f,%.2f,%.1f,%s,%lu,%.1f,%.3f,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f\n",
+                c->dry_cml / 100.0, c->wet_cml / 100.0, c->target_cml / 100.0,
+                c->max_dose_ms / 1000.0, c->dose_mode == DOSE_MODE_PI ? "pi" : "model",
+                (unsigned long)n_tracos, dias, soma.pumped_ml / dias, soma.pump_starts / dias,
+                soma.cycles / dias, soma.lockouts / dias, 100 * abaixo, 100 * acima,
+                100 * (abaixo + acima));
+        // Melhor: menos tempo fora da faixa; empate (0.1%) → menos água
+        double fora = abaixo + acima, agua = soma.pumped_ml / dias;
+        if (fora < melhor_fora - 0.001 || (fora < melhor_fora + 0.001 && agua < melhor_agua)) {
+            melhor = k;
+            melhor_fora = fora;
+            melhor_agua = agua;
+        }
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    double horas = sim_us_total / US_PER_HOUR;
+    fprintf(stderr, "%lu configurações × %lu traços = %lu replays em %lu threads (%lu roubos)\n",
+            (unsigned long)n_configs, (unsigned long)n_tracos, (unsigned long)n_jobs,
+            (unsigned long)pool.threads, (unsigned long)pool.steals);
+    fprintf(stderr, "Simulado: %.0f h em %.2f s = %.2f milhões de horas por minuto "
+                    "(%.1f milhões de passos de controle por segundo)\n",
+            horas, real_s, real_s > 0 ? horas / real_s * 60 / 1e6 : 0,
+            real_s > 0 ? passos / real_s / 1e6 : 0);
+    const replay_config_t *b = &configs[melhor];
+    fprintf(stderr, "Melhor: seco %.2f mL, encharcado %.2f mL, alvo %.2f mL, dose máx %.1f s, %s: "
+                    "%.2f%% fora da faixa, %.2f mL/dia\n",
+            b->dry_cml / 100.0, b->wet_cml / 100.0, b->target_cml / 100.0, b->max_dose_ms / 1000.0,
+            b->dose_mode == DOSE_MODE_PI ? "pi" : "modelo", 100 * melhor_fora, melhor_agua);
+    free(resultados);
+    free(configs);
+    free(tracos);
+    return 0;
+}
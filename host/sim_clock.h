@@ -0,0 +1,15 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+#include <stdint.h>
+
+// Relógio virtual do simulador (implementa hal.h). O tempo só avança
+// quando o código espera (hal_sleep_*, hal_idle), então uma simulação
+// roda tão rápido quanto a CPU permite.
+
+// Fator de velocidade: 0 = sem espera real (máximo), 1 = tempo real,
+// 1000 = mil vezes mais rápido que o tempo real
+void sim_clock_set_speed(double factor);
+void sim_clock_reset(uint64_t now_us);
+
+#endif // SIM_CLOCK_H
@@ -0,0 +1,624 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include <stdio.h>                          // Entrada e saída padrão
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>                         // Opções de linha de comando
+#include <time.h>                           // Tempo real (aceleração obtida)
+#include "hal.h"                            // Relógio virtual
+#include "sim_clock.h"
+#include "soil_model.h"                     // Física do solo e da bomba
+#include "adc_sampler_sim.h"                // ADC virtual
+#include "pump_sim.h"                       // Bomba virtual
+#include "ssd1306_sim.h"                    // Painel virtual (PBM)
+#include "adc_sampler.h"
+#include "pump.h"
+#include "oled_ssd1306.h"                   // Mesmo código gráfico do firmware
+#include "oled_anim.h"
+#include "oled_zones.h"                     // Mesmo painel das zonas
+#include "oled_readout.h"                   // Mesma leitura em texto
+#include "face_sprites.h"
+#include "plant_control.h"                  // Mesmo controle do firmware
+#include "telemetry_frame.h"                // Mesmos quadros da telemetria USB
+#include "flash_log.h"                      // Mesmo histórico da flash
+#include "flash_store_sim.h"                // Flash virtual
+#include "soil_calib.h"                     // Mesma calibração dos sensores
+#include "prof.h"                           // Mesma instrumentação (PICO_PLANT_PROFILE)
+
+// Simulador no Linux: executa o controle e o display do firmware contra
+// um modelo do solo, com relógio virtual.
+
+// ===== Parâmetros da Simulação =====
+#define SIM_CONTROL_PERIOD_US PLANT_CONTROL_PERIOD_US  // Mesmo período da tarefa de controle do core0
+#define SIM_DEFAULT_HOURS 24.0
+#define SIM_DEFAULT_MAX_FRAMES 500
+#define SIM_CSV_INTERVAL_US 1000000         // Uma linha de CSV por zona a cada segundo simulado
+#define SIM_ZONE_LOSS_STEP 0.15f            // Perda de cada zona: +15% em relação à anterior
+#define SIM_CALIB_SETTLE_US 200000          // Espera após "preparar o copo" antes de medir
+
+// ===== OPÇÕES =====
+typedef struct {
+    double hours;
+    double speed;
+    float start_ml;
+    float flow_ml_s;
+    float loss_ml_h;
+    float lag_s;
+    float noise_lsb;
+    uint32_t seed;
+    uint32_t zones;
+    const char *frames_dir;
+    uint32_t max_frames;
+    const char *csv_path;
+    const char *telemetry_path;
+    const char *flash_path;
+    bool calibrate;
+    int dose_mode;              // dose_mode_t
+    bool quiet;
+} sim_options_t;
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "uso: %s [opções]\n"
+            "  --hours H        tempo simulado (padrão %.0f h)\n"
+            "  --speed X        0 = o mais rápido possível, 1 = tempo real (padrão 0)\n"
+            "  --start-ml ML    água inicial no copo (padrão %.0f mL)\n"
+            "  --flow ML/S      vazão da bomba (padrão %.2f mL/s)\n"
+            "  --loss ML/H      evaporação + consumo (padrão %.2f mL/h)\n"
+            "  --lag S          atraso da infiltração até o sensor (padrão %.1f s)\n"
+            "  --noise LSB      ruído do ADC por amostra (padrão 2)\n"
+            "  --seed N         semente do ruído (padrão 1)\n"
+            "  --zones N        zonas da tabela plant_zones.c, um copo e uma bomba cada\n"
+            "                   (padrão 1, máx. %d; a perda cresce 15%% por zona)\n"
+            "  --frames DIR     grava cada quadro do OLED em DIR/frame_NNNNNN.pbm\n"
+            "  --max-frames N   limite de quadros gravados (padrão %d)\n"
+            "  --csv ARQ        uma linha por zona a cada segundo: tempo, zona, água, tensão,\n"
+            "                   estado, bomba\n"
+            "  --telemetry ARQ  fluxo binário igual ao da USB (ver tools/telemetry_decode);\n"
+            "                   termina com o despejo do histórico\n"
+            "  --flash ARQ      imagem da flash do histórico, lida no início e gravada\n"
+            "                   no fim (execuções seguidas = reinicializações)\n"
+            "  --dose-mode M    model (padrão): dose = erro / ganho estimado;\n"
+            "                   pi: PI por dose com anti-windup\n"
+            "  --calibrate      calibração guiada de cada sensor antes de começar,\n"
+            "                   gravada na flash (use com --flash para reaproveitar)\n"
+            "  --quiet          só o resumo final\n",
+            prog, SIM_DEFAULT_HOURS, SOIL_DEFAULT_START_ML, SOIL_DEFAULT_FLOW_ML_S,
+            SOIL_DEFAULT_LOSS_ML_H, SOIL_DEFAULT_LAG_S, PLANT_MAX_ZONES, SIM_DEFAULT_MAX_FRAMES);
+}
+
+static bool parse_options(int argc, char **argv, sim_options_t *opt) {
+    static const struct option longopts[] = {
+        {"hours",      required_argument, 0, 'h'},
+        {"speed",      required_argument, 0, 'x'},
+        {"start-ml",   required_argument, 0, 'm'},
+        {"flow",       required_argument, 0, 'f'},
+        {"loss",       required_argument, 0, 'l'},
+        {"lag",        required_argument, 0, 'g'},
+        {"noise",      required_argument, 0, 'n'},
+        {"seed",       required_argument, 0, 's'},
+        {"zones",      required_argument, 0, 'z'},
+        {"frames",     required_argument, 0, 'F'},
+        {"max-frames", required_argument, 0, 'M'},
+        {"csv",        required_argument, 0, 'c'},
+        {"telemetry",  required_argument, 0, 't'},
+        {"flash",      required_argument, 0, 'H'},
+        {"calibrate",  no_argument,       0, 'C'},
+        {"dose-mode",  required_argument, 0, 'D'},
+        {"quiet",      no_argument,       0, 'q'},
+        {0, 0, 0, 0},
+    };
+    *opt = (sim_options_t){
+        .hours = SIM_DEFAULT_HOURS,
+        .start_ml = SOIL_DEFAULT_START_ML,
+        .flow_ml_s = SOIL_DEFAULT_FLOW_ML_S,
+        .loss_ml_h = SOIL_DEFAULT_LOSS_ML_H,
+        .lag_s = SOIL_DEFAULT_LAG_S,
+        .noise_lsb = 2.0f,
+        .seed = 1,
+        .zones = 1,
+        .dose_mode = DOSE_MODE,
+        .max_frames = SIM_DEFAULT_MAX_FRAMES,
+    };
+    int c;
+    while ((c = getopt_long(argc, argv, "", longopts, NULL)) != -1) {
+        switch (c) {
+            case 'h': opt->hours = atof(optarg); break;
+            case 'x': opt->speed = atof(optarg); break;
+            case 'm': opt->start_ml = (float)atof(optarg); break;
+            case 'f': opt->flow_ml_s = (float)atof(optarg); break;
+            case 'l': opt->loss_ml_h = (float)atof(optarg); break;
+            case 'g': opt->lag_s = (float)atof(optarg); break;
+            case 'n': opt->noise_lsb = (float)atof(optarg); break;
+            case 's': opt->seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'z': opt->zones = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'F': opt->frames_dir = optarg; break;
+            case 'M': opt->max_frames = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'c': opt->csv_path = optarg; break;
+            case 't': opt->telemetry_path = optarg; break;
+            case 'H': opt->flash_path = optarg; break;
+            case 'C': opt->calibrate = true; break;
+            case 'D':
+                if (strcmp(optarg, "pi") == 0) {
+                    opt->dose_mode = DOSE_MODE_PI;
+                } else if (strcmp(optarg, "model") == 0) {
+                    opt->dose_mode = DOSE_MODE_MODEL;
+                } else {
+                    return false;
+                }
+                break;
+            case 'q': opt->quiet = true; break;
+            default: return false;
+        }
+    }
+    return optind == argc && opt->zones >= 1 && opt->zones <= PLANT_MAX_ZONES;
+}
+
+// ===== QUADROS DO OLED =====
+static const char *frames_dir;
+static uint32_t frames_max;
+static uint32_t frames_done;                // Transferências concluídas
+static uint32_t frames_written;
+
+// Chamado por oled_update_poll() ao fim de cada quadro: grava o que o painel mostra
+static void frame_done(void) {
+    frames_done++;
+    if (frames_dir && frames_written < frames_max) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/frame_%06lu.pbm", frames_dir, (unsigned long)frames_written);
+        if (ssd1306_sim_write_pbm(path)) {
+            frames_written++;
+        }
+    }
+}
+
+// ===== TELEMETRIA =====
+static FILE *telemetry_out;
+static uint8_t telemetry_seq;
+
+static void send_record(void *record, size_t len) {
+    if (!telemetry_out) {
+        return;
+    }
+    ((telemetry_header_t *)record)->seq = telemetry_seq++;
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    fwrite(frame, 1, telemetry_encode_frame(record, len, frame), telemetry_out);
+}
+
+static void print_time(uint64_t t_us) {
+    uint64_t s = t_us / 1000000u;
+    printf("[%02lu:%02lu:%02lu.%03lu] ", (unsigned long)(s / 3600), (unsigned long)(s / 60 % 60),
+           (unsigned long)(s % 60), (unsigned long)(t_us / 1000 % 1000));
+}
+
+// Face de todas as zonas: triste enquanto alguma irriga ou encharca
+static const oled_animation_t *face_das_zonas(const plant_zone_t *zonas, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (plant_control_face(zonas[i].fsm.state) == &anim_sad_tears) {
+            return &anim_sad_tears;
+        }
+    }
+    return &anim_happy_blink;
+}
+
+static bool alguma_bomba(uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (pump_is_on(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===== CALIBRAÇÃO GUIADA =====
+// Mesma sessão do comando 'C' pela USB: o "usuário" prepara o copo de cada
+// zona com água conhecida, informa os mL e espera a média do ponto
+static const float calib_pontos_ml[] = {0.0f, 6.0f, 11.0f, 12.0f, 16.0f, 20.0f, 21.0f, 24.0f};
+#define CALIB_PONTOS (sizeof(calib_pontos_ml) / sizeof(calib_pontos_ml[0]))
+
+static bool calibrar(soil_calib_t *tabelas, const plant_zone_t *zonas, uint32_t n_zonas,
+                     bool quiet) {
+    for (uint32_t i = 0; i < n_zonas; i++) {
+        const plant_zone_config_t *cfg = zonas[i].cfg;
+        soil_calib_session_t sessao;
+        soil_calib_session_begin(&sessao, (uint8_t)i);
+        for (uint32_t p = 0; p < CALIB_PONTOS; p++) {
+            adc_sampler_sim_set_voltage(cfg->adc_input, cfg->mux_channel,
+                                        soil_voltage_from_ml(calib_pontos_ml[p]));
+            hal_sleep_until_us(hal_time_us() + SIM_CALIB_SETTLE_US);
+            adc_sampler_reading_t r;
+            while (adc_sampler_poll(&r)) {
+                // Leituras de antes de o copo estar pronto
+            }
+            soil_calib_session_measure(&sessao, (uint16_t)(calib_pontos_ml[p] * 100 + 0.5f),
+                                       hal_time_us());
+            while (sessao.measuring) {
+                hal_sleep_until_us(hal_time_us() + SIM_CONTROL_PERIOD_US);
+                while (adc_sampler_poll(&r)) {
+                    if (plant_control_find_zone(zonas, n_zonas, &r) == (int)i) {
+                        soil_calib_session_sample(&sessao, soil_calib_counts(r.value, r.bits),
+                                                  r.timestamp_us);
+                    }
+                }
+            }
+        }
+        if (!soil_calib_session_finish(&sessao, &tabelas[i])) {
+            return false;
+        }
+        if (!quiet) {
+            printf("Calibração da zona %lu:", (unsigned long)i);
+            for (uint32_t p = 0; p < tabelas[i].count; p++) {
+                printf(" %u.%02u mL = %lu mV", tabelas[i].water_cml[p] / 100,
+                       tabelas[i].water_cml[p] % 100,
+                       (unsigned long)soil_calib_counts_to_mv(tabelas[i].counts[p]));
+            }
+            printf("\n");
+        }
+    }
+    return soil_calib_save(tabelas, n_zonas);
+}
+
+int main(int argc, char **argv) {
+    sim_options_t opt;
+    if (!parse_options(argc, argv, &opt)) {
+        usage(argv[0]);
+        return 2;
+    }
+    FILE *csv = NULL;
+    if (opt.csv_path) {
+        csv = fopen(opt.csv_path, "w");
+        if (!csv) {
+            perror(opt.csv_path);
+            return 1;
+        }
+        fprintf(csv, "t_s,zone,water_ml,sensed_ml,voltage,state,pump\n");
+    }
+    if (opt.telemetry_path) {
+        telemetry_out = fopen(opt.telemetry_path, "wb");
+        if (!telemetry_out) {
+            perror(opt.telemetry_path);
+            return 1;
+        }
+    }
+
+    // === Hardware virtual ===
+    // Um copo por zona; a perda cresce de zona em zona para as doses não
+    // coincidirem sempre (e também disputarem a fonte às vezes)
+    const uint32_t n_zonas = opt.zones;
+#if PICO_PLANT_PROFILE
+    prof_init();
+#endif
+    sim_clock_reset(0);
+    sim_clock_set_speed(opt.speed);
+    static soil_model_t solos[PLANT_MAX_ZONES];
+    static plant_zone_t zonas[PLANT_MAX_ZONES];
+    uint64_t bomba_ant_us[PLANT_MAX_ZONES] = {0};
+    adc_sampler_sim_set_noise(opt.noise_lsb, opt.seed);
+    for (uint32_t i = 0; i < n_zonas; i++) {
+        soil_model_t *solo = &solos[i];
+        soil_model_init(solo, opt.start_ml);
+        solo->flow_ml_s = opt.flow_ml_s;
+        solo->loss_ml_h = opt.loss_ml_h * (1.0f + SIM_ZONE_LOSS_STEP * i);
+        solo->lag_s = opt.lag_s;
+        adc_sampler_sim_set_voltage(plant_zones[i].adc_input, plant_zones[i].mux_channel,
+                                    soil_model_voltage(solo));
+        pump_init(i, plant_zones[i].pump_gpio);
+        plant_control_init(&zonas[i], i);
+        zonas[i].dose.cfg.mode = (uint8_t)opt.dose_mode;
+    }
+
+    adc_sampler_config_t adc_cfg;
+    plant_control_sampler_config(n_zonas, &adc_cfg);
+    adc_sampler_init_config(&adc_cfg,
+                            PLANT_ADC_RATE_HZ * (uint32_t)__builtin_popcount(adc_cfg.input_mask),
+                            ADC_SAMPLER_DEFAULT_OVERSAMPLE);
+
+    frames_dir = opt.frames_dir;
+    frames_max = opt.max_frames;
+    oled_i2c_init(0, 0, OLED_I2C_BAUDRATE);
+    oled_init();
+    oled_set_update_callback(frame_done);
+
+    if (opt.flash_path) {
+        flash_store_sim_load(opt.flash_path);
+    }
+    flash_log_init(n_zonas);
+
+    // Calibração gravada numa execução anterior, ou uma nova guiada
+    static soil_calib_t calibracoes[PLANT_MAX_ZONES];
+    const char *origem = soil_calib_load(calibracoes, n_zonas) ? "da flash" : "padrão";
+    if (opt.calibrate) {
+        origem = calibrar(calibracoes, zonas, n_zonas, opt.quiet) ? "guiada, gravada na flash"
+                                                                   : "guiada, falhou (padrão)";
+    }
+    for (uint32_t i = 0; i < n_zonas; i++) {
+        plant_control_set_calib(&zonas[i], &calibracoes[i]);
+    }
+    uint64_t inicio_us = hal_time_us();     // A calibração guiada também gasta tempo simulado
+
+    oled_anim_player_t rosto;
+    oled_clear();
+    const oled_animation_t *face = face_das_zonas(zonas, n_zonas);
+    oled_anim_play(&rosto, face, FACE_SPRITE_X, 0, hal_time_us());
+    oled_zones_init(n_zonas);
+    oled_zones_draw();
+    oled_readout_init(n_zonas);
+    oled_readout_draw(hal_time_us());
+    oled_update_async();
+
+    // === Laço: controle em taxa fixa + display, como os dois núcleos ===
+    uint64_t fim_us = inicio_us + (uint64_t)(opt.hours * 3600e6);
+    uint64_t prazo = hal_time_us();
+    uint64_t proximo_csv = 0;
+    uint64_t tempo_estado[4] = {0};         // Somado entre as zonas
+    uint64_t estado_desde[PLANT_MAX_ZONES];
+    for (uint32_t i = 0; i < n_zonas; i++) {
+        estado_desde[i] = inicio_us;
+    }
+    uint32_t latencia_max = 0;
+    // Ciclos de irrigação (seco → alvo), somados entre as zonas
+    uint32_t ciclos = 0, ciclos_bloqueados = 0, ciclo_doses = 0;
+    uint64_t ciclo_bomba_ms = 0, ciclo_assentar_ms = 0;
+    int32_t sobressinal_max = 0;
+    uint32_t assentar_max_ms = 0;
+    clock_t inicio_real = clock();
+
+    while (hal_time_us() < fim_us) {
+        prazo += SIM_CONTROL_PERIOD_US;
+        hal_sleep_until_us(prazo);
+
+        // --- Física: água bombeada em cada copo desde o último passo ---
+        for (uint32_t i = 0; i < n_zonas; i++) {
+            uint64_t bomba_us = pump_sim_total_on_us(i);
+            soil_model_step(&solos[i], SIM_CONTROL_PERIOD_US / 1e6f,
+                            (bomba_us - bomba_ant_us[i]) / 1e6f);
+            bomba_ant_us[i] = bomba_us;
+            adc_sampler_sim_set_voltage(plant_zones[i].adc_input, plant_zones[i].mux_channel,
+                                        soil_model_voltage(&solos[i]));
+        }
+
+        // --- Controle: cada leitura nova avança a sua zona ---
+        PROF_BEGIN(t_controle);
+        adc_sampler_reading_t amostra;
+        while (adc_sampler_poll(&amostra)) {
+            int z = plant_control_find_zone(zonas, n_zonas, &amostra);
+            if (z < 0) {
+                continue;
+            }
+            plant_zone_t *zona = &zonas[z];
+            irrigation_state_t anterior = zona->fsm.state;
+            uint32_t latencia;
+            bool mudou = plant_control_step(zona, &amostra, hal_time_us(), &latencia);
+            float tensao = plant_control_voltage(&amostra);
+            flash_log_sample(amostra.timestamp_us, (uint8_t)z,
+                             flash_log_value16(amostra.value, amostra.bits));
+            uint16_t contagens = soil_calib_counts(amostra.value, amostra.bits);
+            uint16_t agua = soil_calib_water(&calibracoes[z], contagens);
+            oled_zones_set(z, agua, zona->cfg->dry_water_cml, soil_calib_max_water(&calibracoes[z]),
+                           zona->fsm.state, zona->fsm.dose_wanted);
+            oled_readout_set(z, agua, soil_calib_max_water(&calibracoes[z]),
+                             soil_calib_counts_to_mv(contagens), pump_is_on(z), amostra.timestamp_us);
+            telemetry_sample_t registro = {
+                .hdr = {TELEMETRY_SAMPLE, 0, (uint32_t)amostra.timestamp_us},
+                .value = amostra.value,
+                .raw = amostra.mean,
+                .water_cml = agua,
+                .bits = amostra.bits,
+                .state = zona->fsm.state,
+                .pump_on = pump_is_on(z),
+                .zone = (uint8_t)z,
+                .jitter_us = 0,
+                .loop_us = 0,
+            };
+            send_record(&registro, sizeof(registro));
+            if (!mudou) {
+                continue;
+            }
+            dose_cycle_report_t ciclo;
+            if (plant_control_take_cycle(zona, &ciclo)) {
+                telemetry_dose_t rega = {
+                    .hdr = {TELEMETRY_DOSE, 0, (uint32_t)amostra.timestamp_us},
+                    .zone = (uint8_t)z,
+                    .doses = ciclo.doses,
+                    .aborted = ciclo.aborted,
+                    .start_cml = ciclo.start_cml,
+                    .end_cml = ciclo.end_cml,
+                    .peak_cml = ciclo.peak_cml,
+                    .target_cml = ciclo.target_cml,
+                    .pump_ms = ciclo.pump_ms,
+                    .settle_ms = ciclo.settle_ms,
+                    .gain_cml_s = telemetry_sat_u16(ciclo.gain_q8 / 256),
+                    .delay_ms = telemetry_sat_u16(ciclo.delay_ms),
+                };
+                send_record(&rega, sizeof(rega));
+                ciclos++;
+                ciclos_bloqueados += ciclo.aborted;
+                ciclo_doses += ciclo.doses;
+                ciclo_bomba_ms += ciclo.pump_ms;
+                ciclo_assentar_ms += ciclo.settle_ms;
+                int32_t sobre = (int32_t)ciclo.peak_cml - ciclo.target_cml;
+                if (sobre > sobressinal_max) sobressinal_max = sobre;
+                if (ciclo.settle_ms > assentar_max_ms) assentar_max_ms = ciclo.settle_ms;
+                if (!opt.quiet) {
+                    print_time(hal_time_us());
+                    printf("Zona %d: ciclo com %u doses, bomba %.1f s, %.2f -> %.2f mL (pico %.2f), "
+                           "assentou em %.1f s; modelo %.2f mL/s, atraso %.1f s\n",
+                           z, ciclo.doses, ciclo.pump_ms / 1e3, ciclo.start_cml / 100.0,
+                           ciclo.end_cml / 100.0, ciclo.peak_cml / 100.0, ciclo.settle_ms / 1e3,
+                           ciclo.gain_q8 / 25600.0, ciclo.delay_ms / 1e3);
+                }
+            }
+            uint32_t espera = zona->fsm.state == IRRIGATION_DOSING ? zona->last_wait_us : 0;
+            telemetry_event_t evento = {
+                .hdr = {TELEMETRY_EVENT, 0, (uint32_t)amostra.timestamp_us},
+                .prev_state = anterior,
+                .state = zona->fsm.state,
+                .reason = zona->fsm.reason,
+                .zone = (uint8_t)z,
+                .pump_off_latency_us = latencia,
+                .wait_ms = telemetry_sat_u16(espera / 1000),
+            };
+            send_record(&evento, sizeof(evento));
+            flash_log_event(amostra.timestamp_us, (uint8_t)z, anterior, zona->fsm.state,
+                            zona->fsm.reason);
+            tempo_estado[anterior] += hal_time_us() - estado_desde[z];
+            estado_desde[z] = hal_time_us();
+            if (latencia > latencia_max) latencia_max = latencia;
+            if (!opt.quiet) {
+                print_time(hal_time_us());
+                printf("Zona %d: %s -> %s (%.2f V, %.2f mL no copo", z,
+                       irrigation_state_name(anterior), irrigation_state_name(zona->fsm.state),
+                       tensao, solos[z].water_ml);
+                if (espera) {
+                    printf(", esperou %.1f s pela bomba", espera / 1e6);
+                }
+                printf(")\n");
+            }
+            const oled_animation_t *nova = face_das_zonas(zonas, n_zonas);
+            if (nova != face) {
+                face = nova;
+                oled_anim_play(&rosto, face, FACE_SPRITE_X, 0, hal_time_us());
+                oled_update_async();
+            }
+        }
+
+        // --- Vez das bombas, dentro do orçamento da fonte ---
+        plant_control_schedule(zonas, n_zonas, PUMP_SUPPLY_BUDGET_MA, hal_time_us());
+        adc_sampler_set_mux_scan(plant_control_mux_focus(zonas, n_zonas));
+        PROF_END(PROF_CONTROL_LOOP, t_controle);
+
+        // --- Histórico: grava só com as bombas desligadas (o tempo da flash
+        // atrasa o próximo passo, como a pausa do core0 no Pico) ---
+        flash_log_poll(hal_time_us(), !alguma_bomba(n_zonas));
+
+        // --- Display ---
+        oled_update_poll();
+        bool desenhou = oled_anim_tick(&rosto, hal_time_us());
+        desenhou |= oled_zones_draw();
+        desenhou |= oled_readout_draw(hal_time_us());
+        if (desenhou) {
+            oled_update_async();
+        }
+
+        if (csv && hal_time_us() >= proximo_csv) {
+            proximo_csv += SIM_CSV_INTERVAL_US;
+            for (uint32_t i = 0; i < n_zonas; i++) {
+                fprintf(csv, "%.0f,%lu,%.3f,%.3f,%.4f,%s,%d\n", hal_time_us() / 1e6,
+                        (unsigned long)i, solos[i].water_ml, solos[i].sensed_ml,
+                        soil_model_voltage(&solos[i]), irrigation_state_name(zonas[i].fsm.state),
+                        pump_is_on(i));
+            }
+        }
+    }
+    for (uint32_t i = 0; i < n_zonas; i++) {
+        tempo_estado[zonas[i].fsm.state] += hal_time_us() - estado_desde[i];
+    }
+    double simulado_us = (double)(hal_time_us() - inicio_us);
+    double real_s = (double)(clock() - inicio_real) / CLOCKS_PER_SEC;
+    if (csv) {
+        fclose(csv);
+    }
+    if (telemetry_out) {
+#if PICO_PLANT_PROFILE
+        // Mesmos histogramas do comando 'P' pela USB
+        for (int i = 0; i < PROF_COUNT; i++) {
+            prof_summary_t s;
+            prof_summary((prof_id_t)i, &s);
+            if (s.count == 0) {
+                continue;
+            }
+            telemetry_profile_t fase = {
+                .hdr = {TELEMETRY_PROFILE, 0, (uint32_t)hal_time_us()},
+                .phase = (uint8_t)i,
+                .count = s.count,
+                .min_ns = s.min_ns,
+                .mean_ns = s.mean_ns,
+                .p50_ns = s.p50_ns,
+                .p99_ns = s.p99_ns,
+                .max_ns = s.max_ns,
+                .overhead_ns = prof_overhead_ns(),
+            };
+            strncpy(fase.name, prof_name((prof_id_t)i), sizeof(fase.name));
+            send_record(&fase, sizeof(fase));
+        }
+#endif
+        // Mesmo despejo do comando pela USB
+        uint32_t total = flash_log_dump_count();
+        for (uint32_t n = 0; n < total; n++) {
+            telemetry_log_page_t pagina = {
+                .hdr = {TELEMETRY_LOG_PAGE, 0, (uint32_t)hal_time_us()},
+                .index = (uint16_t)n,
+                .total = (uint16_t)total,
+            };
+            size_t len;
+            if (flash_log_dump_page(n, pagina.page, &len)) {
+                send_record(&pagina, offsetof(telemetry_log_page_t, page) + len);
+            }
+        }
+        fclose(telemetry_out);
+    }
+    if (opt.flash_path && !flash_store_sim_save(opt.flash_path)) {
+        perror(opt.flash_path);
+    }
+
+    // === Resumo ===
+    adc_sampler_stats_t st;
+    adc_sampler_get_stats(&st);
+    double sim_s = simulado_us / 1e6;
+    printf("Simulado: %.1f h em %.2f s (%.0fx o tempo real)\n", sim_s / 3600, real_s,
+           real_s > 0 ? sim_s / real_s : 0);
+    uint32_t doses = 0;
+    uint64_t ligada_us = 0;
+    float bombeado = 0, no_copo = 0;
+    for (uint32_t i = 0; i < n_zonas; i++) {
+        doses += pump_sim_starts(i);
+        ligada_us += pump_sim_total_on_us(i);
+        bombeado += solos[i].pumped_ml;
+        no_copo += solos[i].water_ml;
+    }
+    printf("Doses: %lu, bomba ligada %.1f s, %.2f mL bombeados, %.2f mL no copo ao final\n",
+           (unsigned long)doses, ligada_us / 1e6, bombeado, no_copo);
+    if (n_zonas > 1) {
+        for (uint32_t i = 0; i < n_zonas; i++) {
+            printf("  Zona %lu: %lu doses, %.2f mL bombeados, %.2f mL no copo, espera máx %lu ms\n",
+                   (unsigned long)i, (unsigned long)pump_sim_starts(i), solos[i].pumped_ml,
+                   solos[i].water_ml, (unsigned long)(zonas[i].max_wait_us / 1000));
+        }
+        printf("Bombas ligadas ao mesmo tempo: no máximo %lu (fonte: %u mA, %u mA por bomba)\n",
+               (unsigned long)pump_sim_max_concurrent(), PUMP_SUPPLY_BUDGET_MA,
+               plant_zones[0].pump_ma);
+    }
+    if (ciclos) {
+        printf("Ciclos de irrigação: %lu (%lu bloqueados), %.1f doses e %.1f s de bomba por ciclo, "
+               "assentamento médio %.1f s (máx %.1f s), sobressinal máx %.2f mL\n",
+               (unsigned long)ciclos, (unsigned long)ciclos_bloqueados,
+               (double)ciclo_doses / ciclos, ciclo_bomba_ms / 1e3 / ciclos,
+               ciclo_assentar_ms / 1e3 / ciclos, assentar_max_ms / 1e3,
+               sobressinal_max > 0 ? sobressinal_max / 100.0 : 0.0);
+        printf("Modelo da zona 0: %.2f mL/s, atraso %.1f s (%s)\n",
+               zonas[0].dose.gain_q8 / 25600.0, zonas[0].dose.delay_ms / 1e3,
+               opt.dose_mode == DOSE_MODE_PI ? "PI" : "modelo");
+    }
+    printf("Tempo por estado:");
+    for (int s = 0; s < 4; s++) {
+        printf(" %s %.1f%%", irrigation_state_name(s),
+               100.0 * tempo_estado[s] / (simulado_us * n_zonas));
+    }
+    printf("\nCalibração %s: zona 0 seca acima de %lu mV, encharcada abaixo de %lu mV\n", origem,
+           (unsigned long)soil_calib_counts_to_mv(zonas[0].fsm.cfg.dry_counts),
+           (unsigned long)soil_calib_counts_to_mv(zonas[0].fsm.cfg.wet_counts));
+    printf("Latência máx. limiar → bomba desligada: %lu us\n", (unsigned long)latencia_max);
+    printf("Leituras do ADC: %lu, OLED: %lu quadros, %lu bytes (%lu gravados em PBM)\n",
+           (unsigned long)st.readings, (unsigned long)frames_done,
+           (unsigned long)oled_get_total_update_bytes(), (unsigned long)frames_written);
+    flash_log_stats_t historico;
+    flash_log_get_stats(&historico);
+    printf("Histórico (boot %u): %lu páginas gravadas, %lu setores apagados, %lu páginas puladas, "
+           "pausa máx %lu us, %lu registros perdidos\n",
+           flash_log_boot(), (unsigned long)historico.pages_written,
+           (unsigned long)historico.sectors_erased, (unsigned long)historico.pages_skipped,
+           (unsigned long)historico.write_us_max, (unsigned long)historico.records_dropped);
+#if PICO_PLANT_PROFILE
+    prof_print();                           // Nanossegundos do host, não ciclos do RP2040
+#endif
+    return 0;
+}
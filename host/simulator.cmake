@@ -0,0 +1,103 @@
+# Linux simulator: the firmware's control and graphics code against a virtual
+# clock, ADC, pump and SSD1306 (configured with -DPICO_PLANT_SIMULATOR=ON).
+# Included from the top-level CMakeLists.txt so it shares the generated sprites.
+
+set(SIM_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(FIRMWARE_DIR ${CMAKE_CURRENT_LIST_DIR}/../auxiliary_codes)
+
+add_executable(pico_plant_sim
+    ${SIM_DIR}/sim_main.c
+    ${SIM_DIR}/hal_host.c
+    ${SIM_DIR}/soil_model.c
+    ${SIM_DIR}/adc_sampler_sim.c
+    ${SIM_DIR}/pump_sim.c
+    ${SIM_DIR}/oled_bus_sim.c
+    ${SIM_DIR}/flash_store_sim.c
+    ${FIRMWARE_DIR}/oled_ssd1306.c
+    ${FIRMWARE_DIR}/oled_anim.c
+    ${FIRMWARE_DIR}/irrigation_fsm.c
+    ${FIRMWARE_DIR}/dose_control.c
+    ${FIRMWARE_DIR}/plant_control.c
+    ${FIRMWARE_DIR}/plant_zones.c
+    ${FIRMWARE_DIR}/oled_zones.c
+    ${FIRMWARE_DIR}/oled_font.c
+    ${FIRMWARE_DIR}/oled_readout.c
+    ${FIRMWARE_DIR}/text_fmt.c
+    ${FIRMWARE_DIR}/telemetry_frame.c
+    ${FIRMWARE_DIR}/flash_log.c
+    ${FIRMWARE_DIR}/flash_log_format.c
+    ${FIRMWARE_DIR}/soil_calib.c
+    ${FIRMWARE_DIR}/prof.c
+    ${FIRMWARE_DIR}/task_sched.c
+    ${FACE_SPRITES_C}
+    )
+
+target_include_directories(pico_plant_sim PRIVATE
+    ${SIM_DIR}
+    ${FIRMWARE_DIR}
+    )
+add_dependencies(pico_plant_sim face_sprites)
+
+target_compile_definitions(pico_plant_sim PRIVATE
+    OLED_I2C_BAUDRATE=${OLED_I2C_BAUDRATE}
+    PICO_PLANT_CONTROL_HZ=${PICO_PLANT_CONTROL_HZ}
+    )
+if (PICO_PLANT_PROFILE)
+    # Host nanoseconds: relative cost of the shared control and graphics code
+    target_compile_definitions(pico_plant_sim PRIVATE PICO_PLANT_PROFILE=1)
+endif()
+target_compile_options(pico_plant_sim PRIVATE -Wall -Wextra)
+target_link_libraries(pico_plant_sim m)
+
+# Trace replay: the same control step over thousands of traces and a grid of
+# thresholds and dose settings, on every core (build with -DCMAKE_BUILD_TYPE=Release)
+find_package(Threads REQUIRED)
+add_executable(pico_plant_replay
+    ${SIM_DIR}/replay_main.c
+    ${SIM_DIR}/replay_hal.c
+    ${SIM_DIR}/work_pool.c
+    ${SIM_DIR}/soil_model.c
+    ${SIM_DIR}/flash_store_sim.c
+    ${FIRMWARE_DIR}/irrigation_fsm.c
+    ${FIRMWARE_DIR}/dose_control.c
+    ${FIRMWARE_DIR}/plant_control.c
+    ${FIRMWARE_DIR}/plant_zones.c
+    ${FIRMWARE_DIR}/soil_calib.c
+    ${FIRMWARE_DIR}/telemetry_frame.c
+    ${FIRMWARE_DIR}/oled_anim.c
+    ${FIRMWARE_DIR}/oled_ssd1306.c
+    ${SIM_DIR}/oled_bus_sim.c
+    ${FACE_SPRITES_C}
+    )
+target_include_directories(pico_plant_replay PRIVATE
+    ${SIM_DIR}
+    ${FIRMWARE_DIR}
+    )
+add_dependencies(pico_plant_replay face_sprites)
+target_compile_options(pico_plant_replay PRIVATE -Wall -Wextra)
+target_link_libraries(pico_plant_replay Threads::Threads m)
+
+# Telemetry decoder: binary USB stream (or a --telemetry capture) to CSV
+add_executable(telemetry_decode
+    ${SIM_DIR}/../tools/telemetry_decode.c
+    ${FIRMWARE_DIR}/telemetry_frame.c
+    ${FIRMWARE_DIR}/flash_log_format.c
+    )
+target_include_directories(telemetry_decode PRIVATE ${FIRMWARE_DIR})
+target_compile_options(telemetry_decode PRIVATE -Wall -Wextra)
+
+# Arc check: the integer oled_draw_arc against the old per-degree cos/sin
+# routine on the face arcs (pixel diff with documented tolerances, timing)
+add_executable(arc_check
+    ${SIM_DIR}/arc_check.c
+    ${SIM_DIR}/hal_host.c
+    ${SIM_DIR}/oled_bus_sim.c
+    ${FIRMWARE_DIR}/oled_ssd1306.c
+    )
+target_include_directories(arc_check PRIVATE
+    ${SIM_DIR}
+    ${FIRMWARE_DIR}
+    )
+target_compile_definitions(arc_check PRIVATE OLED_I2C_BAUDRATE=${OLED_I2C_BAUDRATE})
+target_compile_options(arc_check PRIVATE -Wall -Wextra)
+target_link_libraries(arc_check m)
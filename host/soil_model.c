@@ -0,0 +1,57 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "soil_model.h"                     // Modelo físico do solo
+
+// Pontos medidos (Tabela de Referência da Umidade do Solo, README)
+static const struct {
+    float ml;
+    float volts;
+} curve[] = {
+    { 0.0f, 3.11f},
+    {11.0f, 1.66f},
+    {12.0f, 1.44f},
+    {20.0f, 0.58f},
+    {21.0f, 0.54f},
+};
+#define CURVE_POINTS (int)(sizeof(curve) / sizeof(curve[0]))
+#define MIN_VOLTS 0.30f                     // Solo saturado: a tensão para de cair
+
+float soil_voltage_from_ml(float ml) {
+    if (ml <= curve[0].ml) {
+        return curve[0].volts;
+    }
+    // Interpolação linear entre os pontos; após o último, segue a última inclinação
+    int i = 1;
+    while (i < CURVE_POINTS - 1 && ml > curve[i].ml) {
+        i++;
+    }
+    float t = (ml - curve[i - 1].ml) / (curve[i].ml - curve[i - 1].ml);
+    float v = curve[i - 1].volts + t * (curve[i].volts - curve[i - 1].volts);
+    return v < MIN_VOLTS ? MIN_VOLTS : v;
+}
+
+void soil_model_init(soil_model_t *soil, float start_ml) {
+    soil->water_ml = start_ml;
+    soil->sensed_ml = start_ml;
+    soil->flow_ml_s = SOIL_DEFAULT_FLOW_ML_S;
+    soil->loss_ml_h = SOIL_DEFAULT_LOSS_ML_H;
+    soil->lag_s = SOIL_DEFAULT_LAG_S;
+    soil->pumped_ml = 0;
+}
+
+void soil_model_step(soil_model_t *soil, float dt_s, float pump_on_s) {
+    float in = pump_on_s * soil->flow_ml_s;
+    soil->pumped_ml += in;
+    soil->water_ml += in - soil->loss_ml_h * dt_s / 3600.0f;
+    if (soil->water_ml < 0) {
+        soil->water_ml = 0;
+    }
+
+    // Infiltração: a região do sensor segue a água total com atraso
+    float k = soil->lag_s > 0 ? dt_s / soil->lag_s : 1.0f;
+    if (k > 1.0f) k = 1.0f;
+    soil->sensed_ml += (soil->water_ml - soil->sensed_ml) * k;
+}
+
+float soil_model_voltage(const soil_model_t *soil) {
+    return soil_voltage_from_ml(soil->sensed_ml);
+}
@@ -0,0 +1,37 @@
+#ifndef SOIL_MODEL_H
+#define SOIL_MODEL_H
+
+#include <stdint.h>
+
+// Modelo do copo de teste do README: água (mL) → tensão do sensor.
+// A curva interpola os pontos medidos (0 mL = 3.11 V ... 21 mL = 0.54 V).
+// A água bombeada chega ao sensor com atraso de primeira ordem
+// (infiltração) e o solo perde água a uma taxa constante (evaporação + planta).
+
+typedef struct {
+    float water_ml;          // Água total no copo
+    float sensed_ml;         // Água na região do sensor (atrasada)
+    float flow_ml_s;         // Vazão da bomba
+    float loss_ml_h;         // Perda contínua
+    float lag_s;             // Constante de tempo da infiltração até o sensor
+    float pumped_ml;         // Total bombeado (relatório)
+} soil_model_t;
+
+// Valores padrão do modelo
+#define SOIL_DEFAULT_START_ML 14.0f
+#define SOIL_DEFAULT_FLOW_ML_S 0.5f
+#define SOIL_DEFAULT_LOSS_ML_H 1.0f
+#define SOIL_DEFAULT_LAG_S 8.0f
+
+void soil_model_init(soil_model_t *soil, float start_ml);
+
+// Avança 'dt_s' segundos com a bomba ligada por 'pump_on_s' desse intervalo
+void soil_model_step(soil_model_t *soil, float dt_s, float pump_on_s);
+
+// Tensão do sensor para a água atualmente percebida
+float soil_model_voltage(const soil_model_t *soil);
+
+// Curva medida (README): tensão para uma quantidade de água
+float soil_voltage_from_ml(float ml);
+
+#endif // SOIL_MODEL_H
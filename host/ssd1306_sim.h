@@ -0,0 +1,19 @@
+#ifndef SSD1306_SIM_H
+#define SSD1306_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Painel SSD1306 virtual (implementa oled_bus.h). Interpreta o fluxo de
+// comandos e dados como o controlador real (janelas 0x21/0x22, modo de
+// endereçamento horizontal) e guarda a GDDRAM resultante.
+// O tempo de barramento é modelado com 9 bits por byte na frequência configurada.
+
+bool ssd1306_sim_pixel(int x, int y);
+bool ssd1306_sim_display_on(void);
+uint32_t ssd1306_sim_bytes(void);                    // Bytes recebidos (sem endereço)
+
+// Grava a GDDRAM como PBM binário (P4); display desligado = quadro preto
+bool ssd1306_sim_write_pbm(const char *path);
+
+#endif // SSD1306_SIM_H
@@ -0,0 +1,117 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include "work_pool.h"                      // Pool com roubo de trabalho
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>                         // sysconf (CPUs disponíveis)
+
+#define MAX_THREADS 256
+
+// Uma linha de cache por worker: os CAS de um não invalidam a faixa do outro
+typedef struct {
+    _Alignas(64) _Atomic uint64_t range;    // início << 32 | fim
+    uint32_t index;
+    uint32_t steals;
+    pthread_t thread;
+    bool started;
+    struct pool *pool;
+} worker_t;
+
+typedef struct pool {
+    worker_t *workers;
+    uint32_t count;
+    work_pool_fn_t fn;
+    void *ctx;
+} pool_t;
+
+static uint64_t pack(uint32_t lo, uint32_t hi) {
+    return (uint64_t)lo << 32 | hi;
+}
+
+// Próximo job da própria faixa
+static bool take(worker_t *w, uint32_t *job) {
+    uint64_t r = atomic_load(&w->range);
+    while ((uint32_t)(r >> 32) < (uint32_t)r) {
+        uint32_t lo = (uint32_t)(r >> 32);
+        if (atomic_compare_exchange_weak(&w->range, &r, pack(lo + 1, (uint32_t)r))) {
+            *job = lo;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Metade final da faixa de outro worker (toda, se só restar um job)
+static bool steal(pool_t *pool, worker_t *self) {
+    for (uint32_t i = 1; i < pool->count; i++) {
+        worker_t *victim = &pool->workers[(self->index + i) % pool->count];
+        uint64_t r = atomic_load(&victim->range);
+        while ((uint32_t)(r >> 32) < (uint32_t)r) {
+            uint32_t lo = (uint32_t)(r >> 32), hi = (uint32_t)r;
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (atomic_compare_exchange_weak(&victim->range, &r, pack(lo, mid))) {
+                atomic_store(&self->range, pack(mid, hi));
+                self->steals++;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void *worker_main(void *arg) {
+    worker_t *w = arg;
+    pool_t *pool = w->pool;
+    uint32_t job;
+    do {
+        while (take(w, &job)) {
+            pool->fn(job, w->index, pool->ctx);
+        }
+    } while (steal(pool, w));               // Jobs não criam jobs: sem nada a roubar, acabou
+    return NULL;
+}
+
+void work_pool_run(uint32_t jobs, uint32_t threads, work_pool_fn_t fn, void *ctx,
+                   work_pool_stats_t *stats) {
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (threads > jobs) threads = jobs ? jobs : 1;
+
+    pool_t pool = {
+        .workers = aligned_alloc(64, sizeof(worker_t) * threads),
+        .count = threads,
+        .fn = fn,
+        .ctx = ctx,
+    };
+    for (uint32_t i = 0; i < threads; i++) {
+        worker_t *w = &pool.workers[i];
+        w->index = i;
+        w->steals = 0;
+        w->pool = &pool;
+        atomic_init(&w->range, pack((uint32_t)((uint64_t)jobs * i / threads),
+                                    (uint32_t)((uint64_t)jobs * (i + 1) / threads)));
+    }
+    // O worker 0 é a própria thread que chamou
+    for (uint32_t i = 1; i < threads; i++) {
+        // Sem thread: os outros roubam a faixa dele
+        pool.workers[i].started =
+            pthread_create(&pool.workers[i].thread, NULL, worker_main, &pool.workers[i]) == 0;
+    }
+    worker_main(&pool.workers[0]);
+    uint32_t steals = pool.workers[0].steals;
+    for (uint32_t i = 1; i < threads; i++) {
+        if (pool.workers[i].started) {
+            pthread_join(pool.workers[i].thread, NULL);
+        }
+        steals += pool.workers[i].steals;
+    }
+    free(pool.workers);
+    if (stats) {
+        stats->threads = threads;
+        stats->steals = steals;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <stdint.h>
+
+// Pool de threads com roubo de trabalho para os jobs independentes 0..n-1.
+// Cada worker começa com uma faixa contígua de jobs; ao esvaziá-la, rouba a
+// metade final da faixa de outro worker. A faixa (início, fim) é um único
+// inteiro atômico de 64 bits: o dono avança o início e o ladrão recua o fim,
+// ambos por CAS, então não há trava nenhuma.
+
+typedef void (*work_pool_fn_t)(uint32_t job, uint32_t worker, void *ctx);
+
+typedef struct {
+    uint32_t threads;
+    uint32_t steals;            // Faixas roubadas (desequilíbrio entre os jobs)
+} work_pool_stats_t;
+
+// Executa fn(job, worker, ctx) para cada job e espera todos terminarem.
+// 'threads' = 0 usa um worker por CPU.
+void work_pool_run(uint32_t jobs, uint32_t threads, work_pool_fn_t fn, void *ctx,
+                   work_pool_stats_t *stats);
+
+#endif // WORK_POOL_H
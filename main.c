@@ -1,93 +1,991 @@
 // ===== INCLUSÃO DE BIBLIOTECAS =====
 #include "pico/stdlib.h"                    // Funções básicas do Raspberry Pi Pico
+#include "pico/multicore.h"                 // Segundo núcleo (display e USB)
 #include "hardware/adc.h"                   // Interface para uso do ADC
 #include "auxiliary_codes/pwm_code.h"       // Controle de alimentação via PWM
 #include <stdio.h>                          // Entrada e saída padrão
 #include "hardware/i2c.h"                   // Comunicação I2C
 #include "hardware/gpio.h"                  // Controle de GPIOs
 #include "auxiliary_codes/oled_ssd1306.h"   // Funções gráficas para display OLED
+#include "auxiliary_codes/adc_sampler.h"    // Aquisição do ADC por DMA com sobreamostragem
+#include "auxiliary_codes/irrigation_fsm.h" // Máquina de estados da irrigação
+#include "auxiliary_codes/pump.h"           // Bomba com desligamento por alarme de hardware
+#include "auxiliary_codes/oled_anim.h"      // Animações das faces (sprites na flash)
+#include "auxiliary_codes/oled_zones.h"     // Painel das zonas ao lado da face
+#include "auxiliary_codes/oled_readout.h"   // Umidade, tensão e última rega em texto
+#if PICO_PLANT_STATUS_DISPLAY
+#include "auxiliary_codes/status_display.h" // Segundo display (template C++)
+#endif
+#include "auxiliary_codes/face_sprites.h"   // Posição dos sprites das faces
+#include "auxiliary_codes/spsc_queue.h"     // Fila sem trava core0 → core1
+#include "auxiliary_codes/low_power.h"      // Sono, gating do sensor e estimativa de energia
+#include "auxiliary_codes/plant_control.h"  // Parâmetros e passo de controle (compartilhado com o simulador)
+#include "auxiliary_codes/telemetry.h"      // Telemetria binária pela USB (COBS + CRC)
+#include "auxiliary_codes/flash_log.h"      // Histórico persistente na flash
+#include "auxiliary_codes/soil_calib.h"     // Calibração dos sensores (contagens → água)
+#include "auxiliary_codes/prof.h"           // Instrumentação das fases (PICO_PLANT_PROFILE)
+#include "auxiliary_codes/task_sched.h"     // Tarefas periódicas com prazos absolutos
+#include "auxiliary_codes/hal.h"            // Espera pelo alarme de hardware
+#include "pico/flash.h"                     // Pausa do core0 durante gravações na flash
+#include <stdlib.h>                         // atoi
+#include <string.h>                         // strncpy
 
 // ===== Definições de Hardware =====
-#define SENSOR_ADC_GPIO 26     // GPIO 26 - Entrada analógica (ADC0) para sensor de umidade
-#define SENSOR_PWR_GPIO 2      // GPIO 2  - Saída PWM para alimentação do sensor
-#define PUMP_GPIO 15           // GPIO 15 - Saída digital para controle da bomba d'água
+// Sensores (ADC) e bombas de cada zona: auxiliary_codes/plant_zones.c
+#define SENSOR_PWR_GPIO 2      // GPIO 2  - Saída PWM para alimentação dos sensores
+#define MUX_S0_GPIO 3          // GPIO 3..5 - Seleção S0..S2 do multiplexador (74HC4051) no ADC2
 #define I2C_SDA 14             // GPIO 14 - Linha de dados I2C
 #define I2C_SCL 11             // GPIO 11 - Linha de clock I2C
 
 // ===== Parâmetros de Sistema =====
-#define SOIL_MIN_VOLTAGE 1.44f      // Tensão mínima: >1.44V = mínimo para o solo estar úmido, depois do seco
-#define SOIL_MAX_VOLTAGE 0.58f      // Tensão máxima: <0.58V = máximo para o solo estar úmido, antes de ficar muito úmido e não matar a planta
+// Limiares e tempos da irrigação: auxiliary_codes/plant_control.h
+// Taxa do controle no core0: PICO_PLANT_CONTROL_HZ (plant_control.h)
+#define REPORT_INTERVAL_MS 1000     // Intervalo entre relatórios pela serial
+#define MSG_QUEUE_LEN 128           // Mensagens core0 → core1 (uma por leitura de zona; ~400 ms de folga com 10 zonas)
+#define DUMP_COMMAND 'D'            // Byte recebido pela USB que inicia o despejo do histórico
+#define CALIB_COMMAND 'C'           // "C<zona>" pela USB inicia a calibração guiada do sensor
+#define CALIB_LINE_LEN 16           // Maior comando de texto aceito pela USB
+#define PROFILE_COMMAND 'P'         // Byte recebido pela USB que despeja os histogramas de tempo
+#define TASKS_COMMAND 'T'           // Byte recebido pela USB que despeja os contadores das tarefas
 
-int main() {
-    // === Inicialização do Sistema ===
-    stdio_init_all();                      // Comunicação serial via USB
-    printf("Inicializando faces animadas...\n");
+// Tarefas do core1 (task_sched): período de cada uma
+#define IO_MESSAGES_PERIOD_US 10000 // Fila do controle (10 zonas a 100 Hz: ~10 mensagens por vez)
+#define IO_OLED_PERIOD_US 1000      // Alimenta o DMA do display, uma janela por vez
+#define IO_USB_PERIOD_US 10000      // Comandos, despejo do histórico e FIFO da USB
+#define IO_DRAW_PERIOD_US (OLED_ANIM_FRAME_MS * 1000u)  // Face, painel e leitura (20 quadros/s)
+#define IO_FLASH_PERIOD_US 100000   // Histórico e calibração na flash
+#define IO_IDLE_PERIOD_US (LOW_POWER_MAX_INTERVAL_MS * 1000u)  // Display apagado: mensagens e USB
+
+// ===== Mensagens do controle (core0) para o display/USB (core1) =====
+typedef struct {
+    uint64_t timestamp_us;          // Instante da leitura usada
+    uint32_t value;                 // Leitura sobreamostrada
+    uint32_t pump_off_latency_us;   // Amostra no limiar → bomba desligada (0 = n/a)
+    uint32_t wait_us;               // Espera pela vez da bomba (ao entrar em DOSING)
+    int32_t jitter_us;              // Atraso do despertar em relação ao prazo
+    uint32_t loop_us;               // Tempo de trabalho da iteração
+    uint16_t raw;                   // Média em 12 bits
+    uint8_t bits;                   // Resolução de 'value'
+    uint8_t state;                  // irrigation_state_t atual
+    uint8_t prev_state;             // Estado anterior (igual a 'state' se não mudou)
+    uint8_t reason;                 // irrigation_reason_t da última transição
+    uint8_t pump_on;                // Saída da bomba da zona após o passo
+    uint8_t zone;                   // Índice na tabela de zonas
+    uint8_t waiting;                // Dose pedida aguardando o orçamento da fonte
+    uint8_t rega_pronta;            // 'rega' traz o resumo de um ciclo que acabou de terminar
+    dose_cycle_report_t rega;
+#if PICO_PLANT_LOW_POWER
+    uint32_t interval_ms;           // Próxima medição (0 = laço contínuo)
+    low_power_cycle_t cycle;        // Tempos do ciclo; display_us é do core1
+#endif
+} controle_msg_t;
+
+// Mensagens em texto só sem a telemetria binária (mesmo canal USB)
+#if PICO_PLANT_TELEMETRY
+#define texto(...) ((void)0)
+#else
+#define texto(...) printf(__VA_ARGS__)
+#endif
+
+// Respostas ao usuário (calibração): com a telemetria, em quadros de texto;
+// nada de printf no meio do fluxo binário
+#if PICO_PLANT_TELEMETRY
+#define conversa(...) telemetry_text(__VA_ARGS__)
+#else
+#define conversa(...) printf(__VA_ARGS__)
+#endif
+
+static controle_msg_t msg_storage[MSG_QUEUE_LEN];
+static spsc_queue_t msg_queue;
+
+// Tarefa de controle do core0 (contadores lidos pelo core1 sob pedido)
+static task_sched_t controle_sched;
+
+// Face de todas as zonas: triste enquanto alguma irriga ou encharca
+static const oled_animation_t *face_das_zonas(const controle_msg_t *zonas) {
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        if (plant_control_face(zonas[i].state) == &anim_sad_tears) {
+            return &anim_sad_tears;
+        }
+    }
+    return &anim_happy_blink;
+}
+
+// ===== Calibração dos sensores =====
+// Escritas pelo core1 (calibração guiada); o core0 relê ao ver a versão mudar
+static soil_calib_t calibracoes[PLANT_ZONE_COUNT];
+static volatile uint32_t calib_versao;
+
+// Sessão guiada pela USB (só o core1):
+//   C<zona>  inicia      <mL>  mede um ponto por SOIL_CALIB_WINDOW_MS
+//   S        grava       A     cancela
+static soil_calib_session_t sessao;
+static bool calibrando;
+static bool calib_gravar;                  // Tabelas novas esperando as bombas desligarem
+
+// ===== Vez da flash =====
+// Gravar a flash pausa o core0 (~45 ms por setor apagado), inclusive o IRQ
+// do alarme que desliga a bomba. O core1 abre um pedido (número ímpar) e só
+// grava depois que o core0 confirma esse mesmo número; com o pedido aberto o
+// core0 não libera doses e só confirma sem bomba ligada nem dose liberada.
+// Número par devolve a vez: um pedido novo precisa de confirmação nova.
+static volatile uint32_t flash_pedido;     // Escrito só pelo core1
+static volatile uint32_t flash_confirmado; // Escrito só pelo core0
+
+// Conversa com o usuário: texto puro, ou quadros de texto com a telemetria binária
+static void calib_comando(const char *linha, uint64_t agora) {
+    uint16_t cml;
+    if (linha[0] == CALIB_COMMAND) {
+        unsigned zona = (unsigned)atoi(&linha[1]);
+        if (zona >= PLANT_ZONE_COUNT) {
+            conversa("Calibração: zona %u não existe\n", zona);
+            return;
+        }
+        soil_calib_session_begin(&sessao, (uint8_t)zona);
+        calibrando = true;
+        conversa("Calibração da zona %u: prepare o vaso com água conhecida e envie os mL "
+                 "(até %d pontos); S grava, A cancela\n", zona, SOIL_CALIB_MAX_POINTS);
+    } else if (!calibrando) {
+        return;
+    } else if (linha[0] == 'A' || linha[0] == 'a') {
+        calibrando = false;
+        conversa("Calibração cancelada\n");
+    } else if (linha[0] == 'S' || linha[0] == 's') {
+        soil_calib_t nova;
+        if (sessao.measuring || !soil_calib_session_finish(&sessao, &nova)) {
+            conversa("Calibração: pontos insuficientes ou fora de ordem (mais água = menos contagens)\n");
+            return;
+        }
+        calibracoes[sessao.zone] = nova;
+        __dmb();                            // Tabela visível antes da versão
+        calib_versao++;
+        calib_gravar = true;
+        calibrando = false;
+        conversa("Calibração da zona %u: %u pontos; gravando na flash com as bombas desligadas\n",
+                 sessao.zone, nova.count);
+    } else if (!soil_calib_parse_cml(linha, &cml)) {
+        conversa("Calibração: envie a água em mL, S ou A\n");
+    } else if (sessao.measuring) {
+        conversa("Calibração: espere o ponto anterior\n");
+    } else if (!soil_calib_session_measure(&sessao, cml, agora)) {
+        conversa("Calibração: tabela cheia, envie S\n");
+    } else {
+        conversa("Medindo %u.%02u mL por %u s...\n", cml / 100, cml % 100,
+                 SOIL_CALIB_WINDOW_MS / 1000);
+    }
+}
+
+#if PICO_PLANT_PROFILE
+// ===== Histogramas das fases, sob pedido (PROFILE_COMMAND) =====
+static void despejar_perfil(void) {
+#if PICO_PLANT_TELEMETRY
+    for (int i = 0; i < PROF_COUNT; i++) {
+        prof_summary_t s;
+        prof_summary((prof_id_t)i, &s);
+        if (s.count == 0) {
+            continue;
+        }
+        telemetry_profile_t fase = {
+            .hdr = {TELEMETRY_PROFILE, 0, time_us_32()},
+            .phase = (uint8_t)i,
+            .count = s.count,
+            .min_ns = s.min_ns,
+            .mean_ns = s.mean_ns,
+            .p50_ns = s.p50_ns,
+            .p99_ns = s.p99_ns,
+            .max_ns = s.max_ns,
+            .overhead_ns = prof_overhead_ns(),
+        };
+        strncpy(fase.name, prof_name((prof_id_t)i), sizeof(fase.name));
+        telemetry_send(&fase, sizeof(fase));
+    }
+#else
+    prof_print();
+#endif
+}
+#endif
+
+// ===== Instrumentação de boot =====
+static uint64_t boot_oled_pronto_us;       // Fim da sequência de inicialização do OLED
+static volatile uint64_t boot_primeiro_quadro_us; // Primeiro quadro completo no painel
+
+// Chamado por oled_update_poll() ao fim de cada quadro enviado por DMA
+static void oled_quadro_enviado(void) {
+    if (boot_primeiro_quadro_us == 0) {
+        boot_primeiro_quadro_us = time_us_64();
+    }
+}
+
+// ===== CORE1: display OLED e USB =====
+// Todo I/O lento fica aqui; o core0 nunca espera por ele. Cada parte é uma
+// tarefa periódica (task_sched): a fila do controle e o barramento do display
+// têm a vez antes da USB, do desenho, da flash e do relatório.
+
+// --- Estado do core1 (só este núcleo escreve) ---
+static task_sched_t io_sched;
+static int io_tarefa_mensagens, io_tarefa_oled, io_tarefa_usb, io_tarefa_desenho, io_tarefa_relatorio;
+static oled_anim_player_t rosto;                    // Face animada
+static controle_msg_t ultimas[PLANT_ZONE_COUNT];    // Última mensagem de cada zona
+static uint32_t i2c_hz;
+static bool oled_ok;
+static bool boot_reportado;
+static int32_t jitter_min = INT32_MAX, jitter_max = INT32_MIN;
+static uint32_t loop_max;
+static bool despejando;                    // Despejo do histórico em andamento
+static uint32_t despejo_pos;
+static char linha[CALIB_LINE_LEN];         // Comando de texto sendo recebido
+static uint32_t linha_len;
+#if PICO_PLANT_LOW_POWER
+// Display ligado por um tempo após cada mudança de estado
+static bool display_ligado = true;
+static uint64_t display_desde_us;
+static uint64_t display_desligar_us;
+static uint32_t display_ciclo_us;
+#endif
+
+// ===== Contadores das tarefas, sob pedido (TASKS_COMMAND) =====
+// Os do core0 são lidos sem trava (valores de 32 bits)
+static void despejar_tarefas(void) {
+#if PICO_PLANT_TELEMETRY
+    const task_sched_t *escalonadores[2] = {&controle_sched, &io_sched};
+    for (uint32_t n = 0; n < 2; n++) {
+        for (uint32_t i = 0; i < escalonadores[n]->count; i++) {
+            const task_sched_task_t *t = &escalonadores[n]->tasks[i];
+            telemetry_task_t tarefa = {
+                .hdr = {TELEMETRY_TASK, 0, time_us_32()},
+                .core = (uint8_t)n,
+                .task = (uint8_t)i,
+                .priority = t->priority,
+                .period_us = t->period_us,
+                .runs = t->runs,
+                .overruns = t->overruns,
+                .misses = t->misses,
+                .late_max_us = t->late_max_us,
+                .exec_max_us = t->exec_max_us,
+            };
+            strncpy(tarefa.name, t->name, sizeof(tarefa.name));
+            telemetry_send(&tarefa, sizeof(tarefa));
+        }
+    }
+#else
+    task_sched_print(&controle_sched, "Core0");
+    task_sched_print(&io_sched, "Core1");
+#endif
+}
+
+#if PICO_PLANT_LOW_POWER
+// Display apagado: só mensagens e USB, em ritmo lento; o core0 acorda o
+// core1 com __sev a cada publicação
+static void io_modo_ocioso(bool ocioso, uint64_t agora) {
+    task_sched_set_enabled(&io_sched, io_tarefa_oled, !ocioso, agora);
+    task_sched_set_enabled(&io_sched, io_tarefa_desenho, !ocioso, agora);
+    task_sched_set_enabled(&io_sched, io_tarefa_relatorio, !ocioso, agora);
+    task_sched_set_period(&io_sched, io_tarefa_mensagens,
+                          ocioso ? IO_IDLE_PERIOD_US : IO_MESSAGES_PERIOD_US, agora);
+    task_sched_set_period(&io_sched, io_tarefa_usb, ocioso ? IO_IDLE_PERIOD_US : IO_USB_PERIOD_US,
+                          agora);
+}
+#endif
+
+// --- Mensagens do controle ---
+static void tarefa_mensagens(void *ctx, uint64_t liberacao, uint64_t agora) {
+    (void)ctx;
+    (void)liberacao;
+    (void)agora;
+    PROF_SCOPE(PROF_MESSAGES);
+    controle_msg_t msg;
+    while (spsc_queue_pop(&msg_queue, &msg)) {
+        if (msg.jitter_us < jitter_min) jitter_min = msg.jitter_us;
+        if (msg.jitter_us > jitter_max) jitter_max = msg.jitter_us;
+        if (msg.loop_us > loop_max) loop_max = msg.loop_us;
+        const oled_animation_t *face_antes = face_das_zonas(ultimas);
+        ultimas[msg.zone] = msg;
+        flash_log_sample(msg.timestamp_us, msg.zone, flash_log_value16(msg.value, msg.bits));
+        uint16_t contagens = soil_calib_counts(msg.value, msg.bits);
+        const soil_calib_t *calib = &calibracoes[msg.zone];
+        uint16_t agua = soil_calib_water(calib, contagens);
+        oled_zones_set(msg.zone, agua, plant_zones[msg.zone].dry_water_cml,
+                       soil_calib_max_water(calib), msg.state, msg.waiting);
+        oled_readout_set(msg.zone, agua, soil_calib_max_water(calib),
+                         soil_calib_counts_to_mv(contagens), msg.pump_on, msg.timestamp_us);
+#if PICO_PLANT_STATUS_DISPLAY
+        status_display_set(msg.zone, agua, soil_calib_max_water(calib), msg.state);
+#endif
+        if (calibrando && msg.zone == sessao.zone &&
+            soil_calib_session_sample(&sessao, contagens, msg.timestamp_us)) {
+            uint32_t n = sessao.count - 1u;
+            conversa("Ponto %lu: %u.%02u mL = %lu mV\n", (unsigned long)sessao.count,
+                     sessao.water_cml[n] / 100, sessao.water_cml[n] % 100,
+                     (unsigned long)soil_calib_counts_to_mv(sessao.counts[n]));
+        }
+#if PICO_PLANT_TELEMETRY
+        // Um registro por leitura de cada zona (até 100 Hz por entrada, ~26 bytes no fio);
+        // durante o despejo o buffer fica para as páginas do histórico
+        telemetry_sample_t amostra = {
+            .hdr = {TELEMETRY_SAMPLE, 0, (uint32_t)msg.timestamp_us},
+            .value = msg.value,
+            .raw = msg.raw,
+            .water_cml = agua,
+            .bits = msg.bits,
+            .state = msg.state,
+            .pump_on = msg.pump_on,
+            .zone = msg.zone,
+            .jitter_us = telemetry_sat_i16(msg.jitter_us),
+            .loop_us = telemetry_sat_u16(msg.loop_us),
+        };
+        if (!despejando && !calibrando) {   // Calibrando: o texto da conversa tem a vez
+            telemetry_send(&amostra, sizeof(amostra));
+        }
+#endif
+
+        if (msg.state != msg.prev_state) {
+            flash_log_event(msg.timestamp_us, msg.zone, msg.prev_state, msg.state, msg.reason);
+#if PICO_PLANT_LOW_POWER
+            if (!display_ligado && oled_set_display_on(true)) {
+                display_ligado = true;
+                display_desde_us = time_us_64();
+#if PICO_PLANT_STATUS_DISPLAY
+                status_display_power(true);
+#endif
+                io_modo_ocioso(false, display_desde_us);
+            }
+            display_desligar_us = time_us_64() + LOW_POWER_DISPLAY_ON_MS * 1000ull;
+#endif
+#if PICO_PLANT_TELEMETRY
+            telemetry_event_t evento = {
+                .hdr = {TELEMETRY_EVENT, 0, (uint32_t)msg.timestamp_us},
+                .prev_state = msg.prev_state,
+                .state = msg.state,
+                .reason = msg.reason,
+                .zone = msg.zone,
+                .pump_off_latency_us = msg.pump_off_latency_us,
+                .wait_ms = telemetry_sat_u16(msg.wait_us / 1000),
+            };
+            telemetry_send(&evento, sizeof(evento));
+#endif
+            texto("Zona %u: %s -> %s\n", msg.zone, irrigation_state_name(msg.prev_state),
+                  irrigation_state_name(msg.state));
+            if (msg.wait_us) {
+                texto("Zona %u esperou %lu ms pela vez da bomba\n", msg.zone,
+                      (unsigned long)(msg.wait_us / 1000));
+            }
+            if (msg.pump_off_latency_us) {
+                texto("Bomba desligada %lu us após cruzar o limiar\n",
+                      (unsigned long)msg.pump_off_latency_us);
+            }
+            if (msg.rega_pronta) {
+                const dose_cycle_report_t *r = &msg.rega;
+#if PICO_PLANT_TELEMETRY
+                telemetry_dose_t rega = {
+                    .hdr = {TELEMETRY_DOSE, 0, (uint32_t)msg.timestamp_us},
+                    .zone = msg.zone,
+                    .doses = r->doses,
+                    .aborted = r->aborted,
+                    .start_cml = r->start_cml,
+                    .end_cml = r->end_cml,
+                    .peak_cml = r->peak_cml,
+                    .target_cml = r->target_cml,
+                    .pump_ms = r->pump_ms,
+                    .settle_ms = r->settle_ms,
+                    .gain_cml_s = telemetry_sat_u16(r->gain_q8 / 256),
+                    .delay_ms = telemetry_sat_u16(r->delay_ms),
+                };
+                telemetry_send(&rega, sizeof(rega));
+#endif
+                texto("Zona %u: ciclo com %u doses, bomba %lu ms, %u.%02u -> %u.%02u mL "
+                      "(pico %u.%02u), assentou em %lu ms; modelo %lu cmL/s, atraso %lu ms\n",
+                      msg.zone, r->doses, (unsigned long)r->pump_ms,
+                      r->start_cml / 100, r->start_cml % 100, r->end_cml / 100, r->end_cml % 100,
+                      r->peak_cml / 100, r->peak_cml % 100, (unsigned long)r->settle_ms,
+                      (unsigned long)(r->gain_q8 / 256), (unsigned long)r->delay_ms);
+            }
+            const oled_animation_t *face = face_das_zonas(ultimas);
+            if (face != face_antes) {
+                texto(face == &anim_sad_tears ? "Mostrando rosto triste :(\n"
+                                              : "Mostrando rosto feliz :)\n");
+                oled_anim_play(&rosto, face, FACE_SPRITE_X, 0, time_us_64());
+                oled_update_async();
+            }
+        }
+#if PICO_PLANT_LOW_POWER
+        // Fim de um ciclo de medição: completa com o tempo de display
+        if (msg.interval_ms) {
+            uint64_t agora = time_us_64();
+            msg.cycle.display_us = display_ciclo_us;
+            if (display_ligado) {
+                msg.cycle.display_us += (uint32_t)(agora - display_desde_us);
+                display_desde_us = agora;
+            }
+            display_ciclo_us = 0;
+#if PICO_PLANT_TELEMETRY
+            telemetry_cycle_t ciclo = {
+                .hdr = {TELEMETRY_CYCLE, 0, (uint32_t)msg.timestamp_us},
+                .interval_ms = msg.interval_ms,
+                .energy_uj = low_power_cycle_energy_uj(&msg.cycle),
+                .avg_ua = low_power_cycle_avg_ua(&msg.cycle),
+            };
+            telemetry_send(&ciclo, sizeof(ciclo));
+#endif
+            texto("Ciclo: próxima medição em %lu ms, %lu uJ (média %lu uA)\n",
+                  (unsigned long)msg.interval_ms,
+                  (unsigned long)low_power_cycle_energy_uj(&msg.cycle),
+                  (unsigned long)low_power_cycle_avg_ua(&msg.cycle));
+        }
+#endif
+    }
+}
+
+// --- Display: avança a transferência por DMA sem bloquear ---
+static void tarefa_oled(void *ctx, uint64_t liberacao, uint64_t agora) {
+    (void)ctx;
+    (void)liberacao;
+    (void)agora;
+    oled_update_poll();
+}
+
+// --- Comandos pela USB: despejo (byte DUMP_COMMAND), perfil (PROFILE_COMMAND),
+// tarefas (TASKS_COMMAND) e calibração (linhas) ---
+static void tarefa_usb(void *ctx, uint64_t liberacao, uint64_t agora) {
+    (void)ctx;
+    (void)liberacao;
+    (void)agora;
+    if (!boot_reportado && boot_primeiro_quadro_us != 0) {
+        boot_reportado = true;
+#if PICO_PLANT_TELEMETRY
+        telemetry_boot_t boot = {
+            .hdr = {TELEMETRY_BOOT, 0, time_us_32()},
+            .oled_ready_us = (uint32_t)boot_oled_pronto_us,
+            .first_frame_us = (uint32_t)boot_primeiro_quadro_us,
+            .i2c_hz = i2c_hz,
+            .oled_ok = oled_ok,
+        };
+        telemetry_send(&boot, sizeof(boot));
+#endif
+        texto("Boot: OLED pronto em %lu us, primeiro quadro em %lu us (%lu bytes, %lu us no barramento)\n",
+              (unsigned long)boot_oled_pronto_us,
+              (unsigned long)boot_primeiro_quadro_us,
+              (unsigned long)oled_get_last_update_bytes(),
+              (unsigned long)oled_get_last_update_us());
+    }
+
+    PROF_SCOPE(PROF_USB);
+    int c;
+    while (!despejando && (c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c == DUMP_COMMAND && linha_len == 0 && !calibrando) {
+            despejando = true;
+            despejo_pos = 0;
+            texto("Despejando o histórico...\n");
+#if PICO_PLANT_PROFILE
+        } else if (c == PROFILE_COMMAND && linha_len == 0 && !calibrando) {
+            despejar_perfil();
+#endif
+        } else if (c == TASKS_COMMAND && linha_len == 0 && !calibrando) {
+            despejar_tarefas();
+        } else if (c == '\n' || c == '\r') {
+            linha[linha_len] = '\0';
+            if (linha_len > 0) {
+                calib_comando(linha, time_us_64());
+            }
+            linha_len = 0;
+        } else if (linha_len < CALIB_LINE_LEN - 1) {
+            linha[linha_len++] = (char)c;
+        }
+    }
+    // Sempre em quadros binários; só o que cabe no buffer a cada volta
+    while (despejando && telemetry_free() >= TELEMETRY_MAX_FRAME) {
+        uint32_t total = flash_log_dump_count();
+        if (despejo_pos >= total) {
+            despejando = false;
+            break;
+        }
+        static telemetry_log_page_t pagina;   // Fora da pilha do core1
+        pagina.hdr = (telemetry_header_t){TELEMETRY_LOG_PAGE, 0, time_us_32()};
+        pagina.index = (uint16_t)despejo_pos;
+        pagina.total = (uint16_t)total;
+        size_t len;
+        if (flash_log_dump_page(despejo_pos++, pagina.page, &len)) {
+            telemetry_send(&pagina, offsetof(telemetry_log_page_t, page) + len);
+        }
+    }
+
+    telemetry_poll();                         // Quadros pelo driver stdio_usb
+}
+
+// --- Face, painel das zonas e leitura em texto: só o que mudou ---
+static void tarefa_desenho(void *ctx, uint64_t liberacao, uint64_t agora) {
+    (void)ctx;
+    (void)liberacao;
+#if PICO_PLANT_LOW_POWER
+    if (agora >= display_desligar_us && oled_set_display_on(false)) {
+        display_ligado = false;
+        display_ciclo_us += (uint32_t)(agora - display_desde_us);
+#if PICO_PLANT_STATUS_DISPLAY
+        status_display_power(false);
+#endif
+        io_modo_ocioso(true, agora);
+        return;
+    }
+#endif
+    bool desenhou = oled_anim_tick(&rosto, agora);
+    desenhou |= oled_zones_draw();
+    desenhou |= oled_readout_draw(agora);
+    if (desenhou) {
+        oled_update_async();                  // Envia apenas o que mudou no quadro
+    }
+#if PICO_PLANT_STATUS_DISPLAY
+    status_display_update(agora);             // Bloqueante, mas só as linhas que mudaram
+#endif
+}
+
+// --- Histórico: grava a flash só com as bombas desligadas ---
+// A gravação pausa o core0: só com a vez confirmada por ele (flash_pedido)
+static void tarefa_flash(void *ctx, uint64_t liberacao, uint64_t agora) {
+    (void)ctx;
+    (void)liberacao;
+    PROF_SCOPE(PROF_FLASH);
+    uint32_t pedido = flash_pedido;
+    bool pode_gravar = (pedido & 1u) && flash_confirmado == pedido;
+    if (calib_gravar && pode_gravar) {
+        calib_gravar = false;
+        conversa(soil_calib_save(calibracoes, PLANT_ZONE_COUNT)
+                     ? "Calibração gravada na flash\n"
+                     : "Calibração: falha ao gravar a flash (vale até reiniciar)\n");
+    } else {
+        flash_log_poll(agora, pode_gravar);
+    }
+
+    // Pedido aberto enquanto houver o que gravar; devolvido ao terminar
+    bool gravar = calib_gravar || flash_log_write_pending();
+    if (gravar != ((pedido & 1u) != 0)) {
+        flash_pedido = pedido + 1;
+    }
+}
+
+// --- Relatório periódico ---
+static void tarefa_relatorio(void *ctx, uint64_t liberacao, uint64_t agora) {
+    (void)ctx;
+    (void)liberacao;
+    (void)agora;
+    PROF_SCOPE(PROF_REPORT);
+    if (ultimas[0].bits == 0) {
+        return;                               // Nenhuma leitura ainda
+    }
+    flash_log_stats_t historico;
+    flash_log_get_stats(&historico);
+#if PICO_PLANT_TELEMETRY
+    telemetry_status_t status = {
+        .hdr = {TELEMETRY_STATUS, 0, time_us_32()},
+        .oled_bytes = oled_get_last_update_bytes(),
+        .oled_us = oled_get_last_update_us(),
+        .jitter_min_us = telemetry_sat_i16(jitter_min),
+        .jitter_max_us = telemetry_sat_i16(jitter_max),
+        .loop_max_us = telemetry_sat_u16(loop_max),
+        .queue_depth = (uint8_t)spsc_queue_depth(&msg_queue),
+        .queue_peak = (uint8_t)msg_queue.max_depth,
+        .queue_dropped = msg_queue.dropped,
+        .telemetry_dropped = telemetry_dropped(),
+        .log_pages = historico.pages_written,
+        .log_write_us_max = historico.write_us_max,
+    };
+    telemetry_send(&status, sizeof(status));
+#else
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        const controle_msg_t *z = &ultimas[i];
+        uint16_t contagens = z->bits ? soil_calib_counts(z->value, z->bits) : 0;
+        uint16_t agua = soil_calib_water(&calibracoes[i], contagens);
+        printf("Zona %lu: leitura ADC %d\tTensão: %lu mV\tÁgua: %u.%02u mL\tEstado: %s%s\n",
+               (unsigned long)i, z->raw,
+               (unsigned long)soil_calib_counts_to_mv(contagens), agua / 100, agua % 100,
+               irrigation_state_name(z->state),
+               z->waiting ? " (esperando a bomba)" : "");
+    }
+    printf("OLED: %lu bytes em %lu us\n", (unsigned long)oled_get_last_update_bytes(),
+           (unsigned long)oled_get_last_update_us());
+    printf("Controle: jitter %ld..%ld us, laço máx %lu us, fila %lu (pico %lu)/%d, descartadas %lu\n",
+           (long)jitter_min, (long)jitter_max, (unsigned long)loop_max,
+           (unsigned long)spsc_queue_depth(&msg_queue),
+           (unsigned long)msg_queue.max_depth, MSG_QUEUE_LEN,
+           (unsigned long)msg_queue.dropped);
+    printf("Histórico: %lu páginas gravadas, %lu setores apagados, pausa máx %lu us, %lu registros perdidos\n",
+           (unsigned long)historico.pages_written, (unsigned long)historico.sectors_erased,
+           (unsigned long)historico.write_us_max, (unsigned long)historico.records_dropped);
+#endif
+    jitter_min = INT32_MAX;
+    jitter_max = INT32_MIN;
+    loop_max = 0;
+}
+
+static void core1_io(void) {
+    stdio_init_all();                      // Comunicação serial via USB (IRQ no core1)
+#if PICO_PLANT_PROFILE
+    prof_init();                           // SysTick do core1
+#endif
+    texto("Inicializando faces animadas...\n");
 
     // --- Inicialização do barramento I2C ---
-    i2c_init(I2C_PORT, 100 * 1000);        // Frequência I2C = 100kHz
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);                 // Pull-ups necessários para I2C
-    gpio_pull_up(I2C_SCL);
+    i2c_hz = oled_i2c_init(I2C_SDA, I2C_SCL, OLED_I2C_BAUDRATE); // 400 kHz ou 1 MHz
 
     // --- Inicialização do Display OLED ---
-    printf("Inicializando OLED...\n");
-    sleep_ms(100);
-    oled_init();
-    printf("OLED inicializado! Iniciando animação...\n");
+    // Sem espera fixa: oled_init() repete até o controlador responder
+    texto("Inicializando OLED...\n");
+    oled_ok = oled_init();
+    boot_oled_pronto_us = time_us_64();
+    oled_set_update_callback(oled_quadro_enviado);
+    texto("OLED %s! I2C a %lu Hz. Iniciando animação...\n",
+          oled_ok ? "inicializado" : "sem resposta", (unsigned long)i2c_hz);
+
+    // --- Histórico na flash: continua depois da última página gravada ---
+    if (flash_log_init(PLANT_ZONE_COUNT)) {
+        texto("Histórico: boot %u\n", flash_log_boot());
+    } else {
+        texto("Histórico desativado (programa invade a região da flash)\n");
+    }
+
+    // Face animada: troca de quadro é só uma cópia de sprite da flash
+    oled_clear();
+    oled_anim_play(&rosto, &anim_happy_blink, FACE_SPRITE_X, 0, time_us_64());
+    oled_zones_init(PLANT_ZONE_COUNT);
+    oled_zones_draw();
+    oled_readout_init(PLANT_ZONE_COUNT);
+    oled_readout_draw(time_us_64());
+    oled_update_async();
+#if PICO_PLANT_STATUS_DISPLAY
+    texto(status_display_init(PLANT_ZONE_COUNT) ? "Display de status inicializado\n"
+                                                : "Display de status sem resposta\n");
+#endif
+
+    // --- Tarefas: período próprio, prioridade pela ordem (0 = mais alta) ---
+    uint64_t agora = time_us_64();
+#if PICO_PLANT_LOW_POWER
+    display_desde_us = agora;
+    display_desligar_us = agora + LOW_POWER_DISPLAY_ON_MS * 1000ull;
+#endif
+    task_sched_init(&io_sched);
+    io_tarefa_mensagens = task_sched_add(&io_sched, "mensagens", tarefa_mensagens, NULL,
+                                         IO_MESSAGES_PERIOD_US, 0, agora);
+    io_tarefa_oled = task_sched_add(&io_sched, "oled", tarefa_oled, NULL, IO_OLED_PERIOD_US, 1, agora);
+    io_tarefa_usb = task_sched_add(&io_sched, "usb", tarefa_usb, NULL, IO_USB_PERIOD_US, 2, agora);
+    io_tarefa_desenho = task_sched_add(&io_sched, "desenho", tarefa_desenho, NULL,
+                                       IO_DRAW_PERIOD_US, 3, agora);
+    task_sched_add(&io_sched, "flash", tarefa_flash, NULL, IO_FLASH_PERIOD_US, 4, agora);
+    io_tarefa_relatorio = task_sched_add(&io_sched, "relatorio", tarefa_relatorio, NULL,
+                                         REPORT_INTERVAL_MS * 1000u, 5, agora);
+
+    while (true) {
+#if PICO_PLANT_LOW_POWER
+        if (!display_ligado) {
+            // Nada a desenhar: dorme até a próxima tarefa ou até o core0 publicar (__sev)
+            if (spsc_queue_depth(&msg_queue) > 0) {
+                task_sched_trigger(&io_sched, io_tarefa_mensagens, time_us_64());
+            } else if (time_us_64() < task_sched_next_release(&io_sched)) {
+                low_power_wait_until(from_us_since_boot(task_sched_next_release(&io_sched)));
+                continue;
+            }
+        }
+#endif
+        PROF_BEGIN(t_tarefa);                 // Sem a espera entre as tarefas
+        if (task_sched_run_ready(&io_sched)) {
+            PROF_END(PROF_IO_LOOP, t_tarefa);
+        } else {
+            hal_wait_until_us(task_sched_next_release(&io_sched));
+        }
+    }
+}
+
+// ===== CORE0: aquisição das zonas =====
+static adc_sampler_config_t adc_cfg;       // Entradas e multiplexador da tabela de zonas
+static uint32_t adc_taxa_hz;
+
+// Mensagem de uma zona para o core1 (jitter e tempo de laço preenchidos por
+// quem chama); leva o resumo do ciclo de irrigação quando ele termina
+static controle_msg_t mensagem(plant_zone_t *zona, irrigation_state_t anterior,
+                               uint32_t latencia) {
+    controle_msg_t msg = {
+        .timestamp_us = zona->reading.timestamp_us,
+        .value = zona->reading.value,
+        .pump_off_latency_us = latencia,
+        .wait_us = zona->fsm.state != anterior && zona->fsm.state == IRRIGATION_DOSING
+                       ? zona->last_wait_us : 0,
+        .raw = zona->reading.mean,
+        .bits = zona->reading.bits,
+        .state = zona->fsm.state,
+        .prev_state = anterior,
+        .reason = zona->fsm.reason,
+        .pump_on = pump_is_on(zona->id),
+        .zone = zona->id,
+        .waiting = zona->fsm.dose_wanted,
+    };
+    msg.rega_pronta = plant_control_take_cycle(zona, &msg.rega);
+    return msg;
+}
+
+// Tabelas novas da calibração guiada: limiares convertidos de novo para contagens
+static void aplicar_calibracao(plant_zone_t *zonas) {
+    static uint32_t aplicada;
+    uint32_t versao = calib_versao;
+    if (versao == aplicada) {
+        return;
+    }
+    aplicada = versao;
+    __dmb();                                // Tabelas lidas depois da versão
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        plant_control_set_calib(&zonas[i], &calibracoes[i]);
+    }
+}
+
+#if PICO_PLANT_LOW_POWER
+// Todas as zonas ociosas ou bloqueadas, sem dose pedida: pode dormir
+static bool zonas_ociosas(const plant_zone_t *zonas) {
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        irrigation_state_t s = zonas[i].fsm.state;
+        if ((s != IRRIGATION_IDLE && s != IRRIGATION_LOCKOUT) || zonas[i].fsm.dose_wanted) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Liga os sensores, espera estabilizar e mede cada zona por uma janela curta.
+// Os sensores e o sampler ficam ligados; quem chama desliga se continuar
+// ocioso. Retorna as zonas medidas (bit n = zona n).
+static uint32_t medir_janela(const plant_zone_t *zonas, adc_sampler_reading_t *out) {
+    set_pwm_power(SENSOR_PWR_GPIO, true);
+    sleep_ms(LOW_POWER_SETTLE_MS);
+    // Vez da flash com o core1: o DMA só parte depois da devolução
+    while ((flash_pedido & 1u) && flash_confirmado == flash_pedido) {
+        sleep_ms(1);
+    }
+    adc_sampler_init_config(&adc_cfg, adc_taxa_hz, ADC_SAMPLER_DEFAULT_OVERSAMPLE);
+
+    // Média de algumas leituras decimadas por zona, no máximo pelo dobro do
+    // tempo delas; o IRQ do DMA acorda o WFI.
+    // Os canais do multiplexador se revezam na mesma entrada: janela mais longa.
+    uint64_t soma[PLANT_ZONE_COUNT] = {0}, soma_media[PLANT_ZONE_COUNT] = {0};
+    uint32_t n[PLANT_ZONE_COUNT] = {0};
+    uint32_t completas = 0;
+    uint32_t canais = adc_cfg.mux_channels ? adc_cfg.mux_channels : 1;
+    adc_sampler_reading_t r;
+    absolute_time_t limite = make_timeout_time_ms(LOW_POWER_WINDOW_READINGS * 2000 / PLANT_SENSE_HZ * canais);
+    while (completas < PLANT_ZONE_COUNT && !time_reached(limite)) {
+        if (!adc_sampler_poll(&r)) {
+            __wfi();
+            continue;
+        }
+        int z = plant_control_find_zone(zonas, PLANT_ZONE_COUNT, &r);
+        if (z < 0 || n[z] == LOW_POWER_WINDOW_READINGS) {
+            continue;
+        }
+        soma[z] += r.value;
+        soma_media[z] += r.mean;
+        out[z] = r;
+        if (++n[z] == LOW_POWER_WINDOW_READINGS) {
+            completas++;
+        }
+    }
+
+    uint32_t medidas = 0;
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        if (n[i] > 0) {
+            out[i].value = (uint32_t)(soma[i] / n[i]);
+            out[i].mean = (uint16_t)(soma_media[i] / n[i]);
+            medidas |= 1u << i;
+        }
+    }
+    return medidas;
+}
+
+static void desligar_sensor(void) {
+    adc_sampler_stop();
+    set_pwm_power(SENSOR_PWR_GPIO, false);
+}
+#endif
+
+// ===== CORE0: sensoriamento e bombas em taxa fixa =====
+// Orçamento das bombas nesta volta: zero com a flash pedida pelo core1, que
+// recebe a vez quando nenhuma bomba está ligada nem tem dose liberada (sem
+// liberações novas, nenhuma bomba liga até o pedido ser devolvido).
+// O sampler para antes de confirmar: durante o apagamento este núcleo fica
+// com os IRQs desligados e ninguém processaria os blocos do DMA. Volta a
+// rodar, do início do round-robin, quando o pedido é devolvido.
+static uint32_t orcamento_bombas(const plant_zone_t *zonas) {
+    uint32_t pedido = flash_pedido;
+    if (!(pedido & 1u)) {
+        adc_sampler_resume();               // Sem efeito se não foi pausado
+        return PUMP_SUPPLY_BUDGET_MA;
+    }
+    if (flash_confirmado != pedido) {
+        for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+            if (pump_is_on(zonas[i].id) || zonas[i].fsm.dose_granted) {
+                return 0;
+            }
+        }
+        adc_sampler_pause();
+        flash_confirmado = pedido;
+    }
+    return 0;
+}
+
+// Uma volta do controle por liberação (PICO_PLANT_CONTROL_HZ): leituras novas,
+// passo de cada zona (bomba acionada dentro do passo) e vez das bombas
+static void tarefa_controle(void *ctx, uint64_t liberacao, uint64_t inicio) {
+    plant_zone_t *zonas = ctx;
+    int32_t jitter = (int32_t)(inicio - liberacao);
+    PROF_SCOPE(PROF_CONTROL_LOOP);            // Do despertar ao fim da volta
 
+    // --- Leituras novas, cada uma para a sua zona ---
+    adc_sampler_reading_t leitura;
+    while (adc_sampler_poll(&leitura)) {
+        int z = plant_control_find_zone(zonas, PLANT_ZONE_COUNT, &leitura);
+        if (z < 0) {
+            continue;
+        }
+        irrigation_state_t anterior = zonas[z].fsm.state;
+        uint32_t latencia;
+        plant_control_step(&zonas[z], &leitura, inicio, &latencia);
+
+        // --- Publica para o core1 (nunca bloqueia; fila cheia descarta) ---
+        controle_msg_t msg = mensagem(&zonas[z], anterior, latencia);
+        msg.jitter_us = jitter;
+        msg.loop_us = (uint32_t)(time_us_64() - inicio);
+        spsc_queue_push(&msg_queue, &msg);
+    }
+
+    // --- Vez das bombas: doses dentro do orçamento da fonte (ou da flash) ---
+    plant_control_schedule(zonas, PLANT_ZONE_COUNT, orcamento_bombas(zonas), inicio);
+    // Multiplexador lê mais vezes as zonas irrigando
+    adc_sampler_set_mux_scan(plant_control_mux_focus(zonas, PLANT_ZONE_COUNT));
+#if PICO_PLANT_LOW_POWER
+    __sev();
+#endif
+}
+
+int main() {
     // === Configuração de Hardware ===
+    spsc_queue_init(&msg_queue, msg_storage, sizeof(controle_msg_t), MSG_QUEUE_LEN);
+    soil_calib_load(calibracoes, PLANT_ZONE_COUNT);  // Sem calibração gravada: curva padrão
+    flash_safe_execute_core_init();        // O core1 pode pausar este núcleo para gravar a flash
+    multicore_launch_core1(core1_io);      // Display e USB no segundo núcleo
 
-    // --- Alimentação do sensor por PWM ---
-    setup_pwm_power(SENSOR_PWR_GPIO);      // Estabiliza 3.3V via PWM para sensor analógico
+    // --- Alimentação dos sensores por PWM ---
+    setup_pwm_power(SENSOR_PWR_GPIO);      // Estabiliza 3.3V via PWM para os sensores analógicos
 
-    // --- Controle da bomba d'água ---
-    gpio_init(PUMP_GPIO);                  
-    gpio_set_dir(PUMP_GPIO, GPIO_OUT);     // Configura GPIO como saída
+    // --- Bombas d'água, uma por zona ---
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        pump_init(i, plant_zones[i].pump_gpio);  // GPIO como saída, bomba desligada
+    }
 
     // --- Inicialização do ADC ---
-    adc_init();                            
-    adc_gpio_init(SENSOR_ADC_GPIO);        // Ativa função analógica no GPIO 26
-    adc_select_input(0);                   // Seleciona canal 0 do ADC
+    // Entradas da tabela em round-robin via DMA, cada uma a uma leitura por
+    // volta do controle (256x → leituras de 16 bits, até 100 Hz), repartidas
+    // entre os canais do multiplexador no ADC2. O sensoriamento é cadenciado
+    // pelo próprio ADC, sem depender do laço
+    adc_init();
+    plant_control_sampler_config(PLANT_ZONE_COUNT, &adc_cfg);
+    adc_cfg.mux_select_gpio = MUX_S0_GPIO;
+    adc_taxa_hz = PLANT_ADC_RATE_HZ * (uint32_t)__builtin_popcount(adc_cfg.input_mask);
+    adc_sampler_init_config(&adc_cfg, adc_taxa_hz, ADC_SAMPLER_DEFAULT_OVERSAMPLE);
 
     // === Controle Inteligente ===
-    int motor_desligado = 0;               // Flag de estado da bomba
-                                           // 0 = bomba pode ser ligada
-                                           // 1 = bomba já foi desligada após solo umedecido
+    static plant_zone_t zonas[PLANT_ZONE_COUNT];
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        plant_control_init(&zonas[i], i);
+        plant_control_set_calib(&zonas[i], &calibracoes[i]);  // Limiares em contagens
+    }
 
-    // === Loop Principal ===
+    // === Loop de Controle ===
+    // Prazos absolutos (task_sched): o período não acumula atraso e o core0
+    // não faz I/O lento; entre as voltas, o núcleo espera um alarme de hardware
+#if PICO_PLANT_PROFILE
+    prof_init();                           // SysTick do core0 (laço e IRQ do ADC)
+#endif
+    task_sched_init(&controle_sched);
+    task_sched_add(&controle_sched, "controle", tarefa_controle, zonas, PLANT_CONTROL_PERIOD_US, 0,
+                   time_us_64());
+#if PICO_PLANT_LOW_POWER
+    // Todas ociosas ou bloqueadas: mede em janelas e dorme entre elas.
+    // Alguma irrigando/encharcando/esperando: laço contínuo, para desligar a bomba no limiar.
+    bool continuo = true;
+    low_power_interval_t intervalos[PLANT_ZONE_COUNT];
+    for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+        low_power_interval_init(&intervalos[i]);
+    }
+    adc_sampler_reading_t leituras[PLANT_ZONE_COUNT];
+    uint64_t ultima_medicao_us = time_us_64();
+#endif
     while (true) {
-        // --- Leitura do sensor ---
-        uint16_t leitura = adc_read();
-        float tensao = leitura * 3.3f / 4095.0f; 
-        printf("Leitura ADC: %d\tTensão: %.2f V\n", leitura, tensao);
-
-        // --- Lógica de Irrigação ---
-        if (tensao < SOIL_MAX_VOLTAGE && motor_desligado == 0) {
-            // Condição: Menor que 0.58V e bomba não foi desligada
-            printf("Mostrando rosto triste :(\n");
-            draw_sad_face();                      // Exibe rosto triste no OLED
-            gpio_put(PUMP_GPIO, 1);               // Liga a bomba
-            sleep_ms(9000);                       // Irriga por 9 segundos
-        } 
-        else if (tensao >= SOIL_MAX_VOLTAGE) {
-            // Condição: Maior ou igual a 0.58V
-            printf("Mostrando rosto feliz :)\n");
-            draw_happy_face();                    // Exibe rosto feliz no OLED
-            gpio_put(PUMP_GPIO, 0);               // Desliga a bomba
-            motor_desligado = 1;                  // Evita desligamento repetido
-        }
-        else if (tensao < SOIL_MIN_VOLTAGE) {
-            // Condição: Menor que 1.44V
-            printf("Mostrando rosto triste :(\n");
-            draw_sad_face();                      // Exibe rosto triste no OLED
-            motor_desligado = 0;
-            gpio_put(PUMP_GPIO, 1);               // Liga a bomba
-            sleep_ms(9000);                       // Irriga por 9 segundos
-        }
-
-        // Aguarda 1 segundo antes da próxima leitura
-        sleep_ms(1000);                           
+        aplicar_calibracao(zonas);
+#if PICO_PLANT_LOW_POWER
+        if (zonas_ociosas(zonas)) {
+            if (continuo) {
+                desligar_sensor();
+                continuo = false;
+            }
+
+            // Próxima medição: a zona de menor intervalo, antecipada para o fim de um bloqueio
+            uint64_t alvo = UINT64_MAX;
+            for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+                uint64_t t = ultima_medicao_us + intervalos[i].interval_ms * 1000ull;
+                uint64_t fim = zonas[i].fsm.deadline_us;
+                if (fim > ultima_medicao_us && fim < t) {
+                    t = fim;
+                }
+                if (t < alvo) {
+                    alvo = t;
+                }
+            }
+            uint64_t dormiu = time_us_64();
+            low_power_sleep_until(from_us_since_boot(alvo));
+            uint64_t acordou = time_us_64();
+
+            uint32_t medidas = medir_janela(zonas, leituras);
+            uint64_t medido = time_us_64();
+
+            irrigation_state_t anteriores[PLANT_ZONE_COUNT];
+            uint32_t intervalo_ms = LOW_POWER_MAX_INTERVAL_MS;
+            for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+                anteriores[i] = zonas[i].fsm.state;
+                if (medidas & (1u << i)) {
+                    uint32_t latencia;
+                    plant_control_step(&zonas[i], &leituras[i], medido, &latencia);
+                    low_power_interval_update(&intervalos[i], plant_control_voltage(&leituras[i]),
+                                              acordou);
+                }
+                if (intervalos[i].interval_ms < intervalo_ms) {
+                    intervalo_ms = intervalos[i].interval_ms;
+                }
+            }
+            plant_control_schedule(zonas, PLANT_ZONE_COUNT, orcamento_bombas(zonas), medido);
+            if (!zonas_ociosas(zonas)) {
+                continuo = true;                  // Sensores e sampler seguem ligados
+                task_sched_resync(&controle_sched, time_us_64());
+            } else {
+                desligar_sensor();
+            }
+            ultima_medicao_us = acordou;
+
+            // Uma mensagem por zona medida; a última fecha o ciclo
+            for (uint32_t i = 0; i < PLANT_ZONE_COUNT; i++) {
+                if (!(medidas & (1u << i))) {
+                    continue;
+                }
+                controle_msg_t msg = mensagem(&zonas[i], anteriores[i], 0);
+                msg.jitter_us = (int32_t)(acordou - alvo);
+                msg.loop_us = (uint32_t)(time_us_64() - acordou);
+                if ((medidas >> i) == 1) {
+                    msg.interval_ms = intervalo_ms;
+                    msg.cycle = (low_power_cycle_t){
+                        .awake_us = (uint32_t)(time_us_64() - acordou),
+                        .sleep_us = (uint32_t)(acordou - dormiu),
+                        .sensor_us = (uint32_t)(medido - acordou),
+                    };
+                }
+                spsc_queue_push(&msg_queue, &msg);
+            }
+            __sev();                              // Acorda o core1
+            continue;
+        }
+#endif
+        task_sched_poll(&controle_sched);
     }
 
     return 0;
@@ -97,23 +995,62 @@ int main() {
  * ===== RESUMO DO FUNCIONAMENTO =====
  * 
  * 1. INICIALIZAÇÃO:
- *    - PWM no GPIO 2 alimenta sensor de umidade
- *    - GPIO 15 configurado para controlar bomba
- *    - ADC configurado para ler GPIO 26
+ *    - PWM no GPIO 2 alimenta os sensores de umidade
+ *    - Uma bomba por zona, nos GPIOs da tabela (plant_zones.c)
+ *    - ADC em free-running (round-robin entre ADC0..ADC2 com várias zonas);
+ *      o DMA preenche blocos e o IRQ decima 256 amostras em cada leitura de
+ *      16 bits (adc_sampler). Um 74HC4051 no ADC2 (S0..S2 nos GPIOs 3..5)
+ *      reparte essa entrada entre até 8 zonas
  * 
- * 2. CICLO DE MONITORAMENTO (a cada 1 segundo):
- *    - Lê tensão do sensor (0-3.3V)
- *    - Compara com os limiares definidos
- *    - Controla bomba e exibe rosto no OLED conforme a umidade
+ * 2. DIVISÃO ENTRE OS NÚCLEOS:
+ *    - CORE0: tarefa de controle em taxa fixa (PICO_PLANT_CONTROL_HZ, 100 Hz
+ *      por padrão, prazos absolutos acordados por um alarme de hardware):
+ *      lê os sensores, avança a máquina de estados de cada zona e aciona as
+ *      bombas; o escalonador libera doses por ordem de chegada sem passar
+ *      da corrente da fonte (PUMP_SUPPLY_BUDGET_MA)
+ *    - CORE1: display OLED e USB; recebe o estado por uma fila sem trava
+ *      (spsc_queue) e relata jitter do laço, tempo de trabalho e ocupação
+ *      da fila, mostrando que o controle não sofre com atrasos de I/O; ao lado
+ *      da face, uma barra de umidade e o estado de cada zona (oled_zones);
+ *      do outro lado, a umidade em %, a tensão e a última rega em texto
+ *      (oled_readout), redesenhando só os caracteres que mudaram
+ *    - Tarefas (task_sched): cada núcleo roda as suas com período e
+ *      prioridade próprios, contando atraso, tempo de execução, prazos
+ *      perdidos e liberações puladas; o byte 'T' pela USB despeja tudo
+ *    - Histórico: o core1 grava médias da umidade e as mudanças de estado
+ *      de cada zona em páginas na flash (anel de setores), só com as bombas
+ *      desligadas;
+ *      o byte 'D' pela USB despeja tudo (tools/telemetry_decode)
+ *    - Calibração: tabela contagens → água por sensor no último setor da
+ *      região; "C<zona>" pela USB guia a medição de pontos com água conhecida
+ *    - Modo de baixo consumo (PICO_PLANT_LOW_POWER): todas as zonas ociosas
+ *      ou bloqueadas, o core0 liga os sensores só durante a medição e dorme entre medições,
+ *      com intervalo adaptativo; o core1 apaga o OLED e espera eventos
+ *    - Instrumentação (PICO_PLANT_PROFILE): cada fase dos dois laços e cada
+ *      primitiva do OLED vai para um histograma de ciclos (SysTick); o byte
+ *      'P' pela USB despeja mín/média/p99/máx de cada uma
  * 
- * 3. ESTADOS DO SISTEMA (baseado na lógica atual):
- *    - SOLO MUITO ÚMIDO (tensão < 0.58V e motor_desligado == 0): Liga bomba por 9 segundos, mostra rosto triste
- *    - SOLO ÚMIDO (tensão >= 0.58V): Desliga bomba, mostra rosto feliz, evita desligamento repetido
- *    - SOLO SECO (tensão > 1.44V): Liga bomba por 9 segundos, mostra rosto triste, permite novo ciclo
+ * 3. ESTADOS DO SISTEMA (tensão alta = solo seco; limiares em água,
+ *    convertidos para contagens do ADC pela calibração de cada sensor):
+ *    - OCIOSO:      solo adequado, bomba desligada
+ *    - IRRIGANDO:   menos de 12 mL (1.44V na curva padrão); dose de 0.2 a 9 s
+ *                   calculada para levar o vaso ao alvo (15 mL) com o ganho
+ *                   estimado (dose_control), sem desligar no limiar
+ *    - ENCHARCANDO: bomba desligada até a leitura assentar (o atraso estimado
+ *                   sem subir); abaixo do alvo, nova dose (até 5 consecutivas).
+ *                   Cada resposta atualiza o ganho e o atraso do vaso
+ *    - BLOQUEADO:   mais de 20 mL (0.58V) ou doses demais; bomba bloqueada por 60 segundos
  * 
- * 4. PREVENÇÃO DE CICLOS:
- *    - Flag 'motor_desligado' evita comandos repetidos de desligamento da bomba
- *    - Melhora eficiência e durabilidade do sistema
+ * 4. SEGURANÇA E LATÊNCIA:
+ *    - A dose termina por um alarme de hardware (add_alarm_in_ms), mesmo que
+ *      o laço esteja ocupado atualizando o display
+ *    - O laço nunca dorme por segundos: a bomba desliga milissegundos após a
+ *      amostra que cruzou o limiar de encharcado, e essa latência é informada
+ *      pela serial, assim como o resumo de cada ciclo de irrigação (água,
+ *      tempo de bomba, sobressinal e assentamento)
+ *    - Os rostos são sprites gerados em tempo de build (tools/gen_face_sprites)
+ *      e animados a 20 quadros/s (piscar, lágrima caindo); cada quadro é
+ *      copiado para o back buffer e enviado por DMA (oled_update_async)
  * 
  * ===== TABELA DE REFERÊNCIA (Baseada em dados experimentais) =====
  * 
@@ -124,7 +1061,7 @@ int main() {
  * | V <= 0.54  | mL >= 21  | Muito Úmido      |
  * 
  * O sistema considera:
- * - SOLO MUITO ÚMIDO:     tensão < 0.58V e motor_desligado == 0 (bomba ON)
- * - SOLO ÚMIDO:           tensão >= 0.58V (bomba OFF)
- * - SOLO SECO:            tensão < 1.44V (bomba ON, libera novo ciclo)
+ * - SOLO SECO:            tensão > 1.44V (irriga em doses adaptativas até o alvo)
+ * - SOLO ÚMIDO ADEQUADO:  0.58V <= tensão <= 1.44V (bomba OFF)
+ * - SOLO MUITO ÚMIDO:     tensão < 0.58V (bomba bloqueada)
  */
\ No newline at end of file
@@ -0,0 +1,147 @@
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include <stdio.h>                          // Entrada e saída padrão
+#include "oled_ssd1306.h"                   // Primitivas de desenho do driver
+#include "ssd1306_sim.h"                    // GDDRAM do painel virtual
+
+// Gera os sprites das faces (1bpp, uma página de 8 linhas por byte) em tempo
+// de build. Cada face é desenhada com as primitivas de oled_ssd1306.c, enviada
+// ao painel virtual do simulador e a GDDRAM resultante vira dados const, que
+// ficam na flash: os sprites são, por construção, o que o driver desenharia.
+// Roda no host (compilado com oled_ssd1306.c, oled_bus_sim.c e hal_host.c).
+//
+// Uso: gen_face_sprites <saida.c>
+
+// ===== Janela dos Sprites =====
+// As faces ocupam as colunas 36..92 (FACE_SPRITE_X em face_sprites.h)
+#define SPRITE_X 32
+#define SPRITE_WIDTH 64
+#define SPRITE_PAGES OLED_PAGES
+
+// ===== FACES =====
+typedef enum {
+    EYES_OPEN,
+    EYES_HALF,
+    EYES_CLOSED,
+} eyes_t;
+
+static void happy_face(eyes_t eyes) {
+    oled_draw_circle(64, 32, 28, false, true);      // Rosto
+    if (eyes == EYES_OPEN) {
+        oled_draw_circle(54, 24, 4, true, true);    // Olhos abertos
+        oled_draw_circle(74, 24, 4, true, true);
+    } else if (eyes == EYES_HALF) {
+        oled_draw_ellipse(54, 24, 4, 2, true, true); // Olhos semicerrados
+        oled_draw_ellipse(74, 24, 4, 2, true, true);
+    } else {
+        oled_draw_line(50, 24, 58, 24, true);       // Olhos fechados
+        oled_draw_line(70, 24, 78, 24, true);
+    }
+    oled_draw_arc(64, 32, 15, 20, 160, true);       // Sorriso
+    oled_draw_circle(42, 35, 3, false, true);       // Bochechas
+    oled_draw_circle(86, 35, 3, false, true);
+}
+
+static void sad_face(int tear_y) {
+    oled_draw_circle(64, 32, 28, false, true);      // Rosto
+    oled_draw_ellipse(54, 24, 3, 5, true, true);    // Olhos tristes
+    oled_draw_ellipse(74, 24, 3, 5, true, true);
+    oled_draw_line(48, 18, 58, 20, true);           // Sobrancelhas
+    oled_draw_line(70, 20, 80, 18, true);
+    oled_draw_arc(64, 48, 12, 200, 340, true);      // Boca triste
+    oled_draw_line(50, 28, 48, 35, true);           // Lágrima escorrendo
+    oled_draw_line(48, 35, 46, 38, true);
+    oled_draw_circle(46, tear_y, 2, true, true);    // Gota
+}
+
+typedef struct {
+    const char *name;
+    bool happy;
+    int arg;                                // Olhos (feliz) ou altura da gota (triste)
+} face_sprite_def_t;
+
+// Um sprite por quadro das animações (oled_anim.c)
+static const face_sprite_def_t sprites[] = {
+    {"face_happy", true, EYES_OPEN},
+    {"face_happy_half", true, EYES_HALF},
+    {"face_happy_closed", true, EYES_CLOSED},
+    {"face_sad", false, 39},
+    {"face_sad_tear1", false, 42},
+    {"face_sad_tear2", false, 45},
+    {"face_sad_tear3", false, 48},
+};
+
+// ===== GERAÇÃO =====
+
+// Byte da GDDRAM: 8 pixels verticais da página
+static uint8_t panel_byte(int x, int page) {
+    uint8_t b = 0;
+    for (int bit = 0; bit < 8; bit++) {
+        if (ssd1306_sim_pixel(x, page * 8 + bit)) {
+            b |= (uint8_t)(1u << bit);
+        }
+    }
+    return b;
+}
+
+// Desenha a face no painel e grava a janela do sprite; false se algum pixel
+// ficou fora dela (o blit perderia parte da face)
+static bool emit_sprite(FILE *f, const face_sprite_def_t *s) {
+    oled_clear();
+    if (s->happy) {
+        happy_face((eyes_t)s->arg);
+    } else {
+        sad_face(s->arg);
+    }
+    oled_update();
+
+    int fora = 0;
+    fprintf(f, "static const uint8_t %s_data[%d] = {\n", s->name, SPRITE_WIDTH * SPRITE_PAGES);
+    for (int page = 0; page < OLED_PAGES; page++) {
+        for (int x = 0; x < OLED_WIDTH; x++) {
+            uint8_t b = panel_byte(x, page);
+            int sx = x - SPRITE_X;
+            if (sx < 0 || sx >= SPRITE_WIDTH || page >= SPRITE_PAGES) {
+                fora += b != 0;
+                continue;
+            }
+            fprintf(f, "%s0x%02X%s", sx % 16 == 0 ? "    " : " ", b, sx % 16 == 15 ? ",\n" : ",");
+        }
+    }
+    fprintf(f, "};\n");
+    fprintf(f, "const oled_sprite_t %s = {%d, %d, %s_data};\n\n",
+            s->name, SPRITE_WIDTH, SPRITE_PAGES, s->name);
+
+    if (fora) {
+        fprintf(stderr, "%s: %d bytes acesos fora da janela do sprite\n", s->name, fora);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <saida.c>\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "w");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    oled_i2c_init(0, 0, OLED_I2C_BAUDRATE);
+    oled_init();
+
+    fprintf(f, "// Arquivo gerado por tools/gen_face_sprites - não editar\n");
+    fprintf(f, "#include \"face_sprites.h\"\n\n");
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(sprites) / sizeof(sprites[0]); i++) {
+        ok &= emit_sprite(f, &sprites[i]);
+    }
+    ok &= fclose(f) == 0;
+    if (!ok) {
+        remove(argv[1]);                    // Sem arquivo parcial: o build refaz
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,299 @@
+// Decodificador da telemetria binária do Pico Plant: lê o fluxo da USB CDC
+// (ou um arquivo gravado) e gera CSV.
+//
+// uso: telemetry_decode [-o PREFIXO] [ENTRADA]
+//   sem -o:  amostras em CSV na saída padrão
+//   com -o:  PREFIXO_sample.csv, PREFIXO_event.csv, PREFIXO_status.csv, ...
+//            e PREFIXO_history.csv com o despejo do histórico da flash
+//   texto (conversa da calibração): sempre na saída de erro, ao chegar,
+//            e em PREFIXO_text.csv com -o
+//   ENTRADA: arquivo ou porta serial já em modo raw (padrão: entrada padrão)
+//
+// Os registros são structs little-endian: o host precisa ser little-endian.
+
+// ===== INCLUSÃO DE BIBLIOTECAS =====
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>                         // getopt
+#include "telemetry_frame.h"                // Formato compartilhado com o firmware
+#include "flash_log_format.h"               // Páginas do histórico
+
+static const char *state_names[] = {"ocioso", "irrigando", "encharcando", "bloqueado"};
+static const char *reason_names[] = {"nenhum", "seco", "limiar", "prazo", "encharcado", "doses",
+                                     "assentou"};
+
+static const char *state_name(uint8_t s) {
+    return s < 4 ? state_names[s] : "?";
+}
+
+static const char *reason_name(uint8_t r) {
+    return r < 7 ? reason_names[r] : "?";
+}
+
+// ===== SAÍDAS =====
+static const char *type_names[] = {NULL, "sample", "event", "status", "boot", "cycle", "history",
+                                   "dose", "profile", "task", "text"};
+#define TYPE_COUNT 11
+
+static const char *headers[TYPE_COUNT] = {
+    NULL,
+    "t_us,seq,zone,value,bits,voltage,raw,water_ml,state,pump,jitter_us,loop_us",
+    "t_us,seq,zone,from,to,reason,pump_off_latency_us,wait_ms",
+    "t_us,seq,oled_bytes,oled_us,jitter_min_us,jitter_max_us,loop_max_us,queue_depth,queue_peak,queue_dropped,telemetry_dropped,log_pages,log_write_us_max",
+    "t_us,seq,oled_ready_us,first_frame_us,i2c_hz,oled_ok",
+    "t_us,seq,interval_ms,energy_uj,avg_ua",
+    "boot,page_seq,t_s,zone,type,value,voltage,from,to,reason",
+    "t_us,seq,zone,doses,aborted,start_ml,end_ml,peak_ml,target_ml,pump_ms,settle_ms,gain_ml_s,delay_ms",
+    "t_us,seq,phase,name,count,min_ns,mean_ns,p50_ns,p99_ns,max_ns,overhead_ns",
+    "t_us,seq,core,task,name,priority,period_us,runs,overruns,misses,late_max_us,exec_max_us",
+    "t_us,seq,text",
+};
+
+static FILE *outputs[TYPE_COUNT];
+static const char *prefix;
+
+static FILE *output_for(uint8_t type) {
+    if (outputs[type]) {
+        return outputs[type];
+    }
+    if (!prefix) {
+        if (type != TELEMETRY_SAMPLE) return NULL;   // Texto: só na saída de erro
+        outputs[type] = stdout;
+    } else {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s_%s.csv", prefix, type_names[type]);
+        outputs[type] = fopen(path, "w");
+        if (!outputs[type]) {
+            perror(path);
+            exit(1);
+        }
+    }
+    fprintf(outputs[type], "%s\n", headers[type]);
+    return outputs[type];
+}
+
+// ===== ESTATÍSTICAS =====
+static unsigned long frames_ok, frames_bad, frames_lost;
+static int last_seq = -1;
+static uint64_t time_base;                  // Desdobra o contador de 32 bits
+static uint32_t last_ts;
+static int have_ts;
+static unsigned long history_pages, history_bad;
+
+static uint64_t unwrap(uint32_t ts) {
+    // Salto para trás de mais de meio período: o contador deu a volta
+    if (have_ts && ts < last_ts && last_ts - ts > 0x80000000u) {
+        time_base += 1ull << 32;
+    }
+    last_ts = ts;
+    have_ts = 1;
+    return time_base + ts;
+}
+
+// Tempo do histórico: desde o boot indicado (o Pico não tem relógio de calendário)
+static void write_history(FILE *f, const uint8_t *page) {
+    if (!flash_log_page_valid(page)) {
+        history_bad++;
+        return;
+    }
+    const flash_log_page_header_t *hdr = (const flash_log_page_header_t *)page;
+    history_pages++;
+    flash_log_reader_t reader;
+    flash_log_record_t rec;
+    flash_log_reader_init(&reader, page);
+    while (flash_log_reader_next(&reader, &rec)) {
+        double t_s = rec.ticks * (FLASH_LOG_TICK_MS / 1000.0);
+        if (rec.type == FLASH_LOG_READING) {
+            fprintf(f, "%u,%lu,%.1f,%u,reading,%u,%.4f,,,\n", hdr->boot, (unsigned long)hdr->seq,
+                    t_s, rec.zone, rec.value, rec.value * 3.3 / 65535.0);
+        } else {
+            fprintf(f, "%u,%lu,%.1f,%u,event,,,%s,%s,%s\n", hdr->boot, (unsigned long)hdr->seq,
+                    t_s, rec.zone, state_name(rec.prev_state), state_name(rec.state),
+                    reason_name(rec.reason));
+        }
+    }
+}
+
+static void handle_record(const uint8_t *rec, size_t len) {
+    telemetry_header_t hdr;
+    memcpy(&hdr, rec, sizeof(hdr));
+    // A página do histórico e o texto só trazem a parte usada
+    size_t expected = telemetry_record_size(hdr.type);
+    bool size_ok = hdr.type == TELEMETRY_LOG_PAGE
+                       ? len > offsetof(telemetry_log_page_t, page) && len <= expected
+                   : hdr.type == TELEMETRY_TEXT
+                       ? len >= offsetof(telemetry_text_t, text) && len <= expected
+                       : len == expected;
+    if (hdr.type >= TYPE_COUNT || !size_ok) {
+        frames_bad++;
+        return;
+    }
+    frames_ok++;
+    if (last_seq >= 0) {
+        frames_lost += (uint8_t)(hdr.seq - last_seq - 1);
+    }
+    last_seq = hdr.seq;
+
+    uint64_t t = unwrap(hdr.timestamp_us);
+    if (hdr.type == TELEMETRY_TEXT) {
+        int n = (int)(len - offsetof(telemetry_text_t, text));
+        fprintf(stderr, "%.*s\n", n, (const char *)rec + offsetof(telemetry_text_t, text));
+    }
+    FILE *f = output_for(hdr.type);
+    if (!f) {
+        return;
+    }
+    switch (hdr.type) {
+        case TELEMETRY_SAMPLE: {
+            telemetry_sample_t r;
+            memcpy(&r, rec, sizeof(r));
+            double volts = r.bits ? r.value * 3.3 / (double)((1u << r.bits) - 1) : 0;
+            fprintf(f, "%llu,%u,%u,%lu,%u,%.4f,%u,%.2f,%s,%u,%d,%u\n", (unsigned long long)t,
+                    r.hdr.seq, r.zone, (unsigned long)r.value, r.bits, volts, r.raw,
+                    r.water_cml / 100.0, state_name(r.state), r.pump_on,
+                    r.jitter_us, r.loop_us);
+            break;
+        }
+        case TELEMETRY_EVENT: {
+            telemetry_event_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%u,%s,%s,%s,%lu,%u\n", (unsigned long long)t, r.hdr.seq, r.zone,
+                    state_name(r.prev_state), state_name(r.state), reason_name(r.reason),
+                    (unsigned long)r.pump_off_latency_us, r.wait_ms);
+            break;
+        }
+        case TELEMETRY_STATUS: {
+            telemetry_status_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%lu,%lu,%d,%d,%u,%u,%u,%lu,%lu,%lu,%lu\n", (unsigned long long)t,
+                    r.hdr.seq, (unsigned long)r.oled_bytes, (unsigned long)r.oled_us,
+                    r.jitter_min_us, r.jitter_max_us, r.loop_max_us, r.queue_depth, r.queue_peak,
+                    (unsigned long)r.queue_dropped, (unsigned long)r.telemetry_dropped,
+                    (unsigned long)r.log_pages, (unsigned long)r.log_write_us_max);
+            break;
+        }
+        case TELEMETRY_BOOT: {
+            telemetry_boot_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%lu,%lu,%lu,%u\n", (unsigned long long)t, r.hdr.seq,
+                    (unsigned long)r.oled_ready_us, (unsigned long)r.first_frame_us,
+                    (unsigned long)r.i2c_hz, r.oled_ok);
+            break;
+        }
+        case TELEMETRY_CYCLE: {
+            telemetry_cycle_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%lu,%lu,%lu\n", (unsigned long long)t, r.hdr.seq,
+                    (unsigned long)r.interval_ms, (unsigned long)r.energy_uj,
+                    (unsigned long)r.avg_ua);
+            break;
+        }
+        case TELEMETRY_DOSE: {
+            telemetry_dose_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%u,%u,%u,%.2f,%.2f,%.2f,%.2f,%lu,%lu,%.2f,%u\n",
+                    (unsigned long long)t, r.hdr.seq, r.zone, r.doses, r.aborted,
+                    r.start_cml / 100.0, r.end_cml / 100.0, r.peak_cml / 100.0,
+                    r.target_cml / 100.0, (unsigned long)r.pump_ms, (unsigned long)r.settle_ms,
+                    r.gain_cml_s / 100.0, r.delay_ms);
+            break;
+        }
+        case TELEMETRY_PROFILE: {
+            telemetry_profile_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%u,%.*s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", (unsigned long long)t,
+                    r.hdr.seq, r.phase, (int)strnlen(r.name, sizeof(r.name)), r.name,
+                    (unsigned long)r.count, (unsigned long)r.min_ns, (unsigned long)r.mean_ns,
+                    (unsigned long)r.p50_ns, (unsigned long)r.p99_ns, (unsigned long)r.max_ns,
+                    (unsigned long)r.overhead_ns);
+            break;
+        }
+        case TELEMETRY_TASK: {
+            telemetry_task_t r;
+            memcpy(&r, rec, sizeof(r));
+            fprintf(f, "%llu,%u,%u,%u,%.*s,%u,%lu,%lu,%lu,%lu,%lu,%lu\n", (unsigned long long)t,
+                    r.hdr.seq, r.core, r.task, (int)strnlen(r.name, sizeof(r.name)), r.name,
+                    r.priority, (unsigned long)r.period_us, (unsigned long)r.runs,
+                    (unsigned long)r.overruns, (unsigned long)r.misses,
+                    (unsigned long)r.late_max_us, (unsigned long)r.exec_max_us);
+            break;
+        }
+        case TELEMETRY_TEXT: {
+            // Entre aspas, com aspas dobradas (a linha pode ter vírgulas)
+            const char *s = (const char *)rec + offsetof(telemetry_text_t, text);
+            size_t n = len - offsetof(telemetry_text_t, text);
+            fprintf(f, "%llu,%u,\"", (unsigned long long)t, hdr.seq);
+            for (size_t i = 0; i < n; i++) {
+                if (s[i] == '"') fputc('"', f);
+                fputc(s[i], f);
+            }
+            fputs("\"\n", f);
+            break;
+        }
+        case TELEMETRY_LOG_PAGE: {
+            telemetry_log_page_t r;
+            memset(&r, 0xFF, sizeof(r));
+            memcpy(&r, rec, len);
+            write_history(f, r.page);
+            break;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    int c;
+    while ((c = getopt(argc, argv, "o:")) != -1) {
+        if (c == 'o') {
+            prefix = optarg;
+        } else {
+            fprintf(stderr, "uso: %s [-o PREFIXO] [ENTRADA]\n", argv[0]);
+            return 2;
+        }
+    }
+    FILE *in = stdin;
+    if (optind < argc) {
+        in = fopen(argv[optind], "rb");
+        if (!in) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    // Acumula até o delimitador 0x00; quadros longos demais são lixo (ex.: texto)
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t len = 0;
+    int overflow = 0;
+    int ch;
+    while ((ch = fgetc(in)) != EOF) {
+        if (ch != 0) {
+            if (len < sizeof(frame)) {
+                frame[len++] = (uint8_t)ch;
+            } else {
+                overflow = 1;
+            }
+            continue;
+        }
+        if (len > 0) {
+            uint8_t rec[TELEMETRY_MAX_RECORD];
+            size_t rec_len;
+            if (!overflow && telemetry_decode_frame(frame, len, rec, &rec_len)) {
+                handle_record(rec, rec_len);
+            } else {
+                frames_bad++;
+            }
+        }
+        len = 0;
+        overflow = 0;
+    }
+
+    for (int t = 0; t < TYPE_COUNT; t++) {
+        if (outputs[t] && outputs[t] != stdout) fclose(outputs[t]);
+    }
+    fprintf(stderr, "%lu quadros, %lu inválidos, %lu perdidos (sequência)\n",
+            frames_ok, frames_bad, frames_lost);
+    if (history_pages || history_bad) {
+        fprintf(stderr, "Histórico: %lu páginas, %lu com CRC inválido\n", history_pages, history_bad);
+    }
+    return 0;
+}